@@ -0,0 +1,20 @@
+TEMPLATE = app
+QT -= gui
+CONFIG += console c++17 silent thread
+CONFIG -= app_bundle
+TARGET = dungeon_benchmark
+SOURCES += src/benchmark.cpp \
+           src/generator.cpp \
+           src/solver.cpp \
+           src/grid.cpp \
+           src/thread_pool.cpp \
+           src/bit_grid.cpp \
+           src/compact_path.cpp
+HEADERS += src/cell.h \
+           src/generator.h \
+           src/solver.h \
+           src/solver_stats.h \
+           src/grid.h \
+           src/thread_pool.h \
+           src/bit_grid.h \
+           src/compact_path.h
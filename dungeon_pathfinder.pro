@@ -1,13 +1,44 @@
 TEMPLATE = app
 QT -= gui
-CONFIG += console c++17 silent
+CONFIG += console c++17 silent thread
 CONFIG -= app_bundle
 SOURCES += src/main.cpp \
            src/generator.cpp \
-           src/solver.cpp
+           src/solver.cpp \
+           src/grid.cpp \
+           src/thread_pool.cpp \
+           src/key_graph.cpp \
+           src/dungeon_index.cpp \
+           src/bit_grid.cpp \
+           src/dungeon_file.cpp \
+           src/dungeon_text.cpp \
+           src/incremental_solver.cpp \
+           src/distance_field.cpp \
+           src/chunked_grid.cpp \
+           src/hierarchical_solver.cpp \
+           src/compact_path.cpp \
+           src/solve_service.cpp \
+           src/solution_cache.cpp \
+           src/connectivity.cpp
 HEADERS += src/cell.h \
            src/generator.h \
-           src/solver.h
+           src/solver.h \
+           src/solver_stats.h \
+           src/grid.h \
+           src/thread_pool.h \
+           src/key_graph.h \
+           src/dungeon_index.h \
+           src/bit_grid.h \
+           src/dungeon_file.h \
+           src/dungeon_text.h \
+           src/incremental_solver.h \
+           src/distance_field.h \
+           src/chunked_grid.h \
+           src/hierarchical_solver.h \
+           src/compact_path.h \
+           src/solve_service.h \
+           src/solution_cache.h \
+           src/connectivity.h
 
 OTHER_FILES += \
     README.md \
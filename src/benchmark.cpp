@@ -0,0 +1,152 @@
+/**
+ * Dungeon Pathfinder - Benchmark Suite
+ *
+ * Standalone baseline for the generator and solvers (dungeon_benchmark.pro).
+ * Sweeps grid sizes and room rates, with and without keys, and reports
+ * median / p99 latency, throughput in cells per second and peak RSS.
+ *
+ *   ./dungeon_benchmark [--sizes 31,255,1023,4095] [--rates 0,20,60] [--keys 2]
+ *
+ * Every configuration uses fixed seeds, so two runs of the same build solve
+ * exactly the same dungeons.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <sys/resource.h>
+#include "generator.h"
+#include "solver.h"
+
+using namespace std;
+
+/**
+ * Helper function: Parse a comma-separated list of integers
+ */
+static vector<int> parseList(const string& text) {
+    vector<int> values;
+    stringstream in(text);
+    string item;
+    while (getline(in, item, ',')) {
+        if (!item.empty()) values.push_back(atoi(item.c_str()));
+    }
+    return values;
+}
+
+/**
+ * Helper function: Peak resident set size of the process so far, in MB
+ */
+static double peakRssMb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);  // Bytes on macOS
+#else
+    return usage.ru_maxrss / 1024.0;             // Kilobytes on Linux
+#endif
+}
+
+/**
+ * Helper function: Value at quantile q (0..1) of the samples, nearest rank
+ */
+static double quantile(vector<double> samples, double q) {
+    sort(samples.begin(), samples.end());
+    size_t rank = static_cast<size_t>(q * (samples.size() - 1) + 0.5);
+    return samples[min(rank, samples.size() - 1)];
+}
+
+/**
+ * Helper function: Repetitions for a grid of cells cells, so that every
+ * configuration takes roughly the same total work (3 to 200 samples)
+ */
+static int repetitionsFor(size_t cells) {
+    return static_cast<int>(max<size_t>(3, min<size_t>(200, 20000000 / cells)));
+}
+
+/**
+ * Helper function: Print one result row
+ */
+static void report(int size, int roomRate, int keys, const string& operation,
+                   const vector<double>& samplesMs, size_t cells) {
+    double median = quantile(samplesMs, 0.5);
+    double p99 = quantile(samplesMs, 0.99);
+    double cellsPerSec = median > 0 ? cells / (median / 1000.0) : 0;
+
+    cout << setw(5) << size << setw(6) << roomRate << setw(5) << keys
+         << "  " << left << setw(20) << operation << right
+         << setw(6) << samplesMs.size()
+         << setw(12) << fixed << setprecision(3) << median
+         << setw(12) << p99
+         << setw(12) << setprecision(1) << cellsPerSec / 1e6
+         << setw(10) << peakRssMb() << '\n';
+    cout.unsetf(ios::floatfield);
+    cout.flush();
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = {31, 255, 1023, 4095};
+    vector<int> rates = {0, 20, 60};
+    int numKeys = 2;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--sizes") == 0) sizes = parseList(argv[i + 1]);
+        else if (strcmp(argv[i], "--rates") == 0) rates = parseList(argv[i + 1]);
+        else if (strcmp(argv[i], "--keys") == 0) numKeys = atoi(argv[i + 1]);
+        else {
+            cout << "Usage: " << argv[0] << " [--sizes 31,255,1023,4095] [--rates 0,20,60] [--keys 2]\n";
+            return 1;
+        }
+    }
+    numKeys = max(0, min(numKeys, 5));  // Door letters available besides 'E'
+
+    cout << "Dungeon Pathfinder benchmark (latency in ms, throughput in Mcells/s, peak RSS in MB)\n";
+    cout << " size  rate keys  operation            runs      median         p99    Mcells/s  peak RSS\n";
+
+    SolverContext ctx;
+    for (int size : sizes) {
+        for (int roomRate : rates) {
+            const size_t cells = static_cast<size_t>(size) * size;
+            const int reps = repetitionsFor(cells);
+            vector<double> generateMs, basicMs, keysPlainMs, keysMs;
+
+            for (int rep = 0; rep < reps; rep++) {
+                uint64_t seed = batchDungeonSeed(static_cast<uint64_t>(size) * 1000 + roomRate, rep);
+                Grid grid;
+
+                auto begin = chrono::steady_clock::now();
+                grid = generateDungeonGrid(size, size, roomRate, seed);
+                auto generated = chrono::steady_clock::now();
+                bfsPath(grid, ctx);
+                auto solved = chrono::steady_clock::now();
+                bfsPathKeys(grid, ctx);
+                auto solvedKeys = chrono::steady_clock::now();
+
+                generateMs.push_back(chrono::duration<double, milli>(generated - begin).count());
+                basicMs.push_back(chrono::duration<double, milli>(solved - generated).count());
+                keysPlainMs.push_back(chrono::duration<double, milli>(solvedKeys - solved).count());
+
+                // Maps that could not take every pair are left out, so the
+                // keys column is exact for all samples
+                if (numKeys > 0 && addKeysAndDoors(grid, numKeys, seed) == numKeys) {
+                    auto keyBegin = chrono::steady_clock::now();
+                    bfsPathKeys(grid, ctx);
+                    auto keyEnd = chrono::steady_clock::now();
+                    keysMs.push_back(chrono::duration<double, milli>(keyEnd - keyBegin).count());
+                }
+            }
+
+            report(size, roomRate, 0, "generateDungeonGrid", generateMs, cells);
+            report(size, roomRate, 0, "bfsPath", basicMs, cells);
+            report(size, roomRate, 0, "bfsPathKeys", keysPlainMs, cells);
+            if (!keysMs.empty()) report(size, roomRate, numKeys, "bfsPathKeys", keysMs, cells);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,289 @@
+/**
+ * Dungeon Pathfinder - Bit-Packed Reachability
+ *
+ * Row-parallel flood fill and word-parallel BFS over a 64-cells-per-word
+ * passability bitmap.
+ */
+
+#include "bit_grid.h"
+#include <algorithm>
+#include <climits>
+#if __cplusplus >= 202002L
+#include <bit>
+#endif
+
+// On x86 with GCC/Clang the AVX2 row merge is compiled with a target
+// attribute and picked at runtime, so the default build ships it too
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BIT_GRID_AVX2_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Helper function: Number of set bits in word
+ */
+static inline int popCount(uint64_t word) {
+#if __cplusplus >= 202002L
+    return std::popcount(word);
+#elif defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * Helper function: Index of the lowest set bit; word must be non-zero
+ */
+static inline int lowestBit(uint64_t word) {
+#if __cplusplus >= 202002L
+    return std::countr_zero(word);
+#elif defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    return popCount((word & (0 - word)) - 1);
+#endif
+}
+
+BitGrid::BitGrid(const GridView& grid)
+    : rows(grid.rows), cols(grid.cols), words((grid.cols + 63) / 64),
+      open(static_cast<size_t>(grid.rows) * ((grid.cols + 63) / 64), 0) {
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            if (isOpenChar(grid.at(r, c))) open[static_cast<size_t>(r) * words + c / 64] |= uint64_t(1) << (c % 64);
+        }
+    }
+}
+
+size_t BitGrid::count() const {
+    size_t total = 0;
+    for (uint64_t word : open) total += popCount(word);
+    return total;
+}
+
+/**
+ * Helper function: Occluded fill toward higher bits. Spreads every set bit of
+ * seeds along the run of set bits in pass that contains it, in 6 doubling
+ * steps (Kogge-Stone); seeds must be a subset of pass.
+ */
+static inline uint64_t fillUp(uint64_t seeds, uint64_t pass) {
+    seeds |= pass & (seeds << 1);  pass &= pass << 1;
+    seeds |= pass & (seeds << 2);  pass &= pass << 2;
+    seeds |= pass & (seeds << 4);  pass &= pass << 4;
+    seeds |= pass & (seeds << 8);  pass &= pass << 8;
+    seeds |= pass & (seeds << 16); pass &= pass << 16;
+    seeds |= pass & (seeds << 32);
+    return seeds;
+}
+
+/**
+ * Helper function: Occluded fill toward lower bits (mirror of fillUp)
+ */
+static inline uint64_t fillDown(uint64_t seeds, uint64_t pass) {
+    seeds |= pass & (seeds >> 1);  pass &= pass >> 1;
+    seeds |= pass & (seeds >> 2);  pass &= pass >> 2;
+    seeds |= pass & (seeds >> 4);  pass &= pass >> 4;
+    seeds |= pass & (seeds >> 8);  pass &= pass >> 8;
+    seeds |= pass & (seeds >> 16); pass &= pass >> 16;
+    seeds |= pass & (seeds >> 32);
+    return seeds;
+}
+
+/**
+ * Helper function: Refill a row after words [lo, hi] gained bits, following
+ * open runs across word boundaries in both directions. The rest of the row
+ * must already be filled. Widens [lo, hi] to every word that changed.
+ */
+static void fillRow(uint64_t* reach, const uint64_t* pass, int words, int& lo, int& hi) {
+    uint64_t carry = lo > 0 ? reach[lo - 1] >> 63 : 0;
+    for (int w = lo; w < words; w++) {
+        uint64_t x = fillUp(reach[w] | (carry & pass[w]), pass[w]);
+        bool grew = x != reach[w];
+        reach[w] = x;
+        carry = x >> 63;
+        if (grew) hi = max(hi, w);
+        else if (w > hi) break;
+    }
+    carry = hi + 1 < words ? reach[hi + 1] & 1 : 0;
+    for (int w = hi; w >= 0; w--) {
+        uint64_t x = fillDown(reach[w] | ((carry << 63) & pass[w]), pass[w]);
+        bool grew = x != reach[w];
+        reach[w] = x;
+        carry = x & 1;
+        if (grew) lo = min(lo, w);
+        else if (w < lo) break;
+    }
+}
+
+/**
+ * Helper function: dst |= src & pass over words [w, hi], widening
+ * [first, last] to the words of dst that changed
+ */
+static inline void mergeWords(uint64_t* dst, const uint64_t* src, const uint64_t* pass, int w, int hi,
+                              int& first, int& last) {
+    for (; w <= hi; w++) {
+        uint64_t merged = dst[w] | (src[w] & pass[w]);
+        if (merged == dst[w]) continue;
+        dst[w] = merged;
+        if (first < 0) first = w;
+        last = w;
+    }
+}
+
+#ifdef BIT_GRID_AVX2_DISPATCH
+/**
+ * Helper function: mergeWords four words per step, skipping groups where
+ * src & pass adds nothing to dst
+ */
+__attribute__((target("avx2")))
+static void mergeWordsAvx2(uint64_t* dst, const uint64_t* src, const uint64_t* pass, int w, int hi,
+                           int& first, int& last) {
+    for (; w + 4 <= hi + 1; w += 4) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + w));
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + w));
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pass + w));
+        __m256i incoming = _mm256_and_si256(s, p);
+        // testc(d, incoming) == 1 iff incoming adds no bits to d
+        if (_mm256_testc_si256(d, incoming)) continue;
+        mergeWords(dst, src, pass, w, w + 3, first, last);
+    }
+    mergeWords(dst, src, pass, w, hi, first, last);
+}
+#endif
+
+/**
+ * Helper function: dst |= src & pass over words [lo, hi]. Narrows [lo, hi]
+ * to the words of dst that changed and returns whether there were any.
+ * Four words per step with AVX2 when the CPU has it.
+ */
+static bool mergeRow(uint64_t* dst, const uint64_t* src, const uint64_t* pass, int& lo, int& hi) {
+    int first = -1, last = -1;
+#ifdef BIT_GRID_AVX2_DISPATCH
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if (hasAvx2) {
+        mergeWordsAvx2(dst, src, pass, lo, hi, first, last);
+    } else {
+        mergeWords(dst, src, pass, lo, hi, first, last);
+    }
+#else
+    mergeWords(dst, src, pass, lo, hi, first, last);
+#endif
+    if (first < 0) return false;
+    lo = first;
+    hi = last;
+    return true;
+}
+
+BitGrid reachableFrom(const BitGrid& map, Cell start) {
+    BitGrid reach;
+    reach.rows = map.rows;
+    reach.cols = map.cols;
+    reach.words = map.words;
+    reach.open.assign(map.open.size(), 0);
+
+    if (start.r < 0 || start.r >= map.rows || start.c < 0 || start.c >= map.cols ||
+        !map.test(start.r, start.c)) {
+        return reach;
+    }
+
+    const int words = map.words;
+    auto row = [&](vector<uint64_t>& bits, int r) { return bits.data() + static_cast<size_t>(r) * words; };
+    const uint64_t* pass = map.open.data();
+
+    // Worklist of (row, lo, hi): words [lo, hi] of row just gained bits, so
+    // both neighbor rows take in that range and refill
+    struct Dirty { int row, lo, hi; };
+    vector<Dirty> dirty;
+
+    int startWord = start.c / 64;
+    int lo = startWord, hi = startWord;
+    reach.open[static_cast<size_t>(start.r) * words + startWord] |= uint64_t(1) << (start.c % 64);
+    fillRow(row(reach.open, start.r), pass + static_cast<size_t>(start.r) * words, words, lo, hi);
+    dirty.push_back({start.r, lo, hi});
+
+    while (!dirty.empty()) {
+        Dirty item = dirty.back();
+        dirty.pop_back();
+        int r = item.row, srcLo = item.lo, srcHi = item.hi;
+
+        for (int n : {r - 1, r + 1}) {
+            if (n < 0 || n >= map.rows) continue;
+            const uint64_t* rowPass = pass + static_cast<size_t>(n) * words;
+            int grownLo = srcLo, grownHi = srcHi;
+            if (mergeRow(row(reach.open, n), row(reach.open, r), rowPass, grownLo, grownHi)) {
+                fillRow(row(reach.open, n), rowPass, words, grownLo, grownHi);
+                dirty.push_back({n, grownLo, grownHi});
+            }
+        }
+    }
+
+    return reach;
+}
+
+std::vector<uint32_t> distanceField(const BitGrid& map, Cell start) {
+    vector<uint32_t> dist(static_cast<size_t>(map.rows) * map.cols, UINT32_MAX);
+    if (start.r < 0 || start.r >= map.rows || start.c < 0 || start.c >= map.cols ||
+        !map.test(start.r, start.c)) {
+        return dist;
+    }
+
+    const int words = map.words;
+    const size_t total = map.open.size();
+    vector<uint64_t> visited(total, 0), current(total, 0), next(total, 0);
+    vector<uint32_t> currentList, nextList;
+
+    size_t startWord = static_cast<size_t>(start.r) * words + start.c / 64;
+    uint64_t startBit = uint64_t(1) << (start.c % 64);
+    visited[startWord] = current[startWord] = startBit;
+    currentList.push_back(static_cast<uint32_t>(startWord));
+    dist[static_cast<size_t>(start.r) * map.cols + start.c] = 0;
+
+    // Adds candidate bits to the next frontier word, keeping nextList to the
+    // words that became non-zero
+    auto emit = [&](size_t word, uint64_t bits) {
+        bits &= map.open[word] & ~visited[word];
+        if (!bits) return;
+        if (!next[word]) nextList.push_back(static_cast<uint32_t>(word));
+        next[word] |= bits;
+    };
+
+    for (uint32_t level = 1; !currentList.empty(); level++) {
+        for (uint32_t word : currentList) {
+            uint64_t frontier = current[word];
+            size_t r = word / words;
+            size_t w = word % words;
+
+            emit(word, (frontier << 1) | (frontier >> 1));
+            if (w + 1 < static_cast<size_t>(words)) emit(word + 1, frontier >> 63);
+            if (w > 0) emit(word - 1, frontier << 63);
+            if (r > 0) emit(word - words, frontier);
+            if (r + 1 < static_cast<size_t>(map.rows)) emit(word + words, frontier);
+
+            current[word] = 0;
+        }
+
+        for (uint32_t word : nextList) {
+            uint64_t bits = next[word];
+            visited[word] |= bits;
+
+            size_t rowBase = (word / words) * map.cols;
+            int colBase = static_cast<int>(word % words) * 64;
+            while (bits) {
+                int bit = lowestBit(bits);
+                dist[rowBase + colBase + bit] = level;
+                bits &= bits - 1;
+            }
+        }
+
+        swap(current, next);
+        swap(currentList, nextList);
+        nextList.clear();
+    }
+
+    return dist;
+}
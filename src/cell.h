@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 
 /**
  * Simple coordinate structure for representing positions in the dungeon.
@@ -19,19 +21,114 @@ struct Cell {
     bool operator!=(const Cell& other) const {
         return !(*this == other);
     }
+
+    // Collision-free 64-bit key: row in the high 32 bits, column in the low 32
+    uint64_t packed() const {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(r)) << 32) |
+               static_cast<uint32_t>(c);
+    }
 };
 
+/**
+ * 64-bit finalizer from SplitMix64. Every input bit affects every output bit,
+ * so packed keys that differ only in low bits still land in different buckets.
+ */
+inline uint64_t mixHash64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
 /**
  * Hash function for using Cell in unordered containers like unordered_set.
  * This enables efficient lookups in the BFS visited tracking.
  */
 struct CellHash {
     size_t operator()(const Cell& cell) const {
-        // Simple hash combining row and column
-        return static_cast<size_t>(cell.r) * 1000 + static_cast<size_t>(cell.c);
+        return static_cast<size_t>(mixHash64(cell.packed()));
+    }
+};
+
+/**
+ * State structure for key-door BFS that includes position and collected keys.
+ *
+ * CONCEPT: In basic BFS, state = (row, col). In key-door BFS, state = (row, col, keys).
+ * The same position with different keys represents different states with different possibilities.
+ *
+ * See BITMASK_BFS_GUIDE.md for detailed explanation of state augmentation concepts.
+ */
+struct KeyState {
+    int row, col;    // Position (same as basic BFS)
+    int keyMask;     // Bitmask representing which keys we have
+
+    // Default constructor (needed for unordered_map)
+    KeyState() : row(0), col(0), keyMask(0) {}
+
+    // Parameterized constructor
+    KeyState(int r, int c, int keys) : row(r), col(c), keyMask(keys) {}
+
+    bool operator==(const KeyState& other) const {
+        return row == other.row && col == other.col && keyMask == other.keyMask;
+    }
+
+    // Collision-free 64-bit key for rows/cols below 2^28 and the 6-key mask:
+    // row in bits 36-63, column in bits 8-35, mask in bits 0-7
+    uint64_t packed() const {
+        return (static_cast<uint64_t>(row & 0xFFFFFFF) << 36) |
+               (static_cast<uint64_t>(col & 0xFFFFFFF) << 8) |
+               static_cast<uint64_t>(keyMask & 0xFF);
     }
 };
 
+/**
+ * Hash function for KeyState to use in unordered containers.
+ */
+struct KeyStateHash {
+    size_t operator()(const KeyState& state) const {
+        return static_cast<size_t>(mixHash64(state.packed()));
+    }
+};
+
+/**
+ * Compile-time character classes for the flat solvers, so the hot loops test
+ * one table byte instead of chains of range comparisons.
+ * Bits 0-2 hold the letter index (0 for 'a'/'A' ... 5 for 'f'/'F').
+ */
+const uint8_t CELL_LETTER_MASK = 0x07;
+const uint8_t CELL_KEY = 0x08;      // 'a'-'f'
+const uint8_t CELL_DOOR = 0x10;     // 'A'-'F' except 'E' (the exit)
+const uint8_t CELL_WALL = 0x20;     // '#'
+const uint8_t CELL_BLOCKED = 0x40;  // Impassable for basic BFS: walls and doors
+
+struct CellClassTable {
+    uint8_t classes[256];
+};
+
+constexpr CellClassTable makeCellClassTable() {
+    CellClassTable table = {};
+    table.classes[static_cast<unsigned char>('#')] = CELL_WALL | CELL_BLOCKED;
+    for (int i = 0; i < 6; i++) {
+        table.classes['a' + i] = static_cast<uint8_t>(CELL_KEY | i);
+        if ('A' + i != 'E') table.classes['A' + i] = static_cast<uint8_t>(CELL_DOOR | CELL_BLOCKED | i);
+    }
+    return table;
+}
+
+inline constexpr CellClassTable CELL_CLASSES = makeCellClassTable();
+
+inline constexpr uint8_t cellClass(char cell) {
+    return CELL_CLASSES.classes[static_cast<unsigned char>(cell)];
+}
+
+// Basic-BFS passability of one character: walls and doors block (same rules
+// as isPassable, without the bounds check)
+inline constexpr bool isOpenChar(char cell) {
+    return !(cellClass(cell) & CELL_BLOCKED);
+}
+
 // Direction vectors for moving in 4 cardinal directions (up, down, left, right)
 // Useful for both maze generation and pathfinding
 const int DIRECTIONS[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
@@ -0,0 +1,32 @@
+/**
+ * Dungeon Pathfinder - Chunked Grid
+ *
+ * Tile-major dungeon layout for the hierarchical solver.
+ */
+
+#include "chunked_grid.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+ChunkedGrid::ChunkedGrid(int rows, int cols, int tileSize)
+    : rows(rows), cols(cols), tileSize(max(tileSize, 1)) {
+    tileRows = (rows + this->tileSize - 1) / this->tileSize;
+    tileCols = (cols + this->tileSize - 1) / this->tileSize;
+    cells.assign(static_cast<size_t>(tileCount()) * this->tileSize * this->tileSize, '#');
+}
+
+ChunkedGrid::ChunkedGrid(const GridView& grid, int tileSize) : ChunkedGrid(grid.rows, grid.cols, tileSize) {
+    start = grid.start;
+    exit = grid.exit;
+
+    // Copy tile by tile, one row segment at a time
+    for (int r = 0; r < rows; r++) {
+        const char* row = grid.cells + static_cast<size_t>(r) * grid.stride;
+        for (int c = 0; c < cols; c += this->tileSize) {
+            int width = min(this->tileSize, cols - c);
+            memcpy(&at(r, c), row + c, width);
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include "cell.h"
+#include "grid.h"
+
+/**
+ * Dungeon stored as fixed-size square tiles, tile-major: tile t occupies
+ * cells[t * tileSize * tileSize ...] in row-major order within the tile, and
+ * tiles are numbered row-major across the map. Tiles on the right and bottom
+ * edges are padded with walls, so every tile has the same shape.
+ *
+ * Keeping each tile contiguous means a solver that only visits some tiles
+ * only touches their pages, and a tile can be searched with tile-local
+ * indices without bounds checks (the padding walls stop the search).
+ */
+struct ChunkedGrid {
+    int rows = 0;
+    int cols = 0;
+    int tileSize = 0;
+    int tileRows = 0;               // Tiles per column of the map
+    int tileCols = 0;               // Tiles per row of the map
+    std::vector<char> cells;        // tileRows * tileCols tiles of tileSize^2 characters
+    Cell start = Cell(-1, -1);
+    Cell exit = Cell(-1, -1);
+
+    ChunkedGrid() = default;
+
+    /**
+     * Creates a rows x cols map of walls in tileSize x tileSize tiles.
+     */
+    ChunkedGrid(int rows, int cols, int tileSize = 64);
+
+    /**
+     * Copies grid into tiles; start and exit are taken from grid.
+     */
+    explicit ChunkedGrid(const GridView& grid, int tileSize = 64);
+
+    int tileCount() const { return tileRows * tileCols; }
+    int tileOf(int row, int col) const { return (row / tileSize) * tileCols + col / tileSize; }
+
+    // First character of tile t
+    const char* tile(int t) const { return cells.data() + static_cast<size_t>(t) * tileSize * tileSize; }
+
+    // Position of tile t's top-left cell
+    Cell tileOrigin(int t) const { return Cell((t / tileCols) * tileSize, (t % tileCols) * tileSize); }
+
+    size_t offset(int row, int col) const {
+        return static_cast<size_t>(tileOf(row, col)) * tileSize * tileSize +
+               static_cast<size_t>(row % tileSize) * tileSize + col % tileSize;
+    }
+    char at(int row, int col) const { return cells[offset(row, col)]; }
+    char& at(int row, int col) { return cells[offset(row, col)]; }
+
+    bool inBounds(int row, int col) const {
+        return row >= 0 && row < rows && col >= 0 && col < cols;
+    }
+};
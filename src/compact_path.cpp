@@ -0,0 +1,67 @@
+/**
+ * Dungeon Pathfinder - Compact Paths
+ *
+ * 2-bit-per-step path encoding, run-length form and cell expansion.
+ */
+
+#include "compact_path.h"
+
+using namespace std;
+
+CompactPath::CompactPath(Cell start, size_t steps)
+    : origin(start), count(steps), packed((steps + 3) / 4, 0) {}
+
+/**
+ * Helper function: Direction code of a single step, or -1 if the cells are
+ * not 4-adjacent
+ */
+static int directionCode(const Cell& from, const Cell& to) {
+    for (int code = 0; code < NUM_DIRECTIONS; code++) {
+        if (from.r + DIRECTIONS[code][0] == to.r && from.c + DIRECTIONS[code][1] == to.c) return code;
+    }
+    return -1;
+}
+
+CompactPath CompactPath::fromCells(const vector<Cell>& cells) {
+    if (cells.empty()) return CompactPath();
+    CompactPath path(cells[0], cells.size() - 1);
+    for (size_t i = 1; i < cells.size(); i++) {
+        int code = directionCode(cells[i - 1], cells[i]);
+        if (code < 0) return CompactPath();
+        path.setDirection(i - 1, static_cast<uint8_t>(code));
+    }
+    return path;
+}
+
+CompactPath CompactPath::fromRuns(Cell start, const vector<uint32_t>& runs) {
+    size_t steps = 0;
+    for (uint32_t run : runs) steps += run >> 2;
+
+    CompactPath path(start, steps);
+    size_t step = 0;
+    for (uint32_t run : runs) {
+        const uint8_t code = run & 3;
+        for (uint32_t i = 0; i < (run >> 2); i++) path.setDirection(step++, code);
+    }
+    return path;
+}
+
+vector<uint32_t> CompactPath::runs() const {
+    vector<uint32_t> result;
+    size_t step = 0;
+    while (step < count) {
+        const uint8_t code = direction(step);
+        size_t length = 1;
+        while (step + length < count && direction(step + length) == code && length < (UINT32_MAX >> 2)) length++;
+        result.push_back(static_cast<uint32_t>(length << 2) | code);
+        step += length;
+    }
+    return result;
+}
+
+vector<Cell> CompactPath::toCells() const {
+    vector<Cell> cells;
+    cells.reserve(size());
+    for (const Cell& cell : *this) cells.push_back(cell);
+    return cells;
+}
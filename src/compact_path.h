@@ -0,0 +1,112 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include "cell.h"
+
+/**
+ * A path stored as its start cell plus one 2-bit direction code per step,
+ * 32x smaller than vector<Cell>. Codes follow DIRECTIONS: 0 up, 1 down,
+ * 2 left, 3 right. Step i lives in bits 2 * (i % 4) of byte i / 4.
+ *
+ * Solvers size it up front (the BFS distance is known when the goal is found)
+ * and write the codes from the back while following parent links from the
+ * goal, so nothing is reversed. Iterating yields the same
+ * cells as the vector<Cell> path, computed on the fly.
+ */
+class CompactPath {
+public:
+    CompactPath() = default;
+
+    /**
+     * Path of the given number of steps from start, every step up (code 0)
+     * until set with setDirection.
+     */
+    CompactPath(Cell start, size_t steps);
+
+    /**
+     * Encodes a vector<Cell> path; consecutive cells must be 4-adjacent.
+     */
+    static CompactPath fromCells(const std::vector<Cell>& cells);
+
+    /**
+     * Decodes runs() output back into a path.
+     */
+    static CompactPath fromRuns(Cell start, const std::vector<uint32_t>& runs);
+
+    bool empty() const { return origin.r == -1; }
+    Cell start() const { return origin; }
+    size_t steps() const { return count; }
+
+    // Number of cells, like vector<Cell>::size() (0 for an empty path)
+    size_t size() const { return empty() ? 0 : count + 1; }
+
+    // Bytes used by the direction codes
+    size_t bytes() const { return packed.size(); }
+
+    uint8_t direction(size_t step) const { return (packed[step >> 2] >> (2 * (step & 3))) & 3; }
+
+    void setDirection(size_t step, uint8_t code) {
+        uint8_t& byte = packed[step >> 2];
+        const int shift = 2 * (step & 3);
+        byte = static_cast<uint8_t>((byte & ~(3u << shift)) | ((code & 3u) << shift));
+    }
+
+    /**
+     * Run-length form: one word per maximal run of equal directions,
+     * (length << 2) | code. A straight corridor of any length is one word.
+     */
+    std::vector<uint32_t> runs() const;
+
+    // Expands into the vector<Cell> form
+    std::vector<Cell> toCells() const;
+
+    /**
+     * Forward iterator over the path's cells, decoding one step at a time.
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Cell;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Cell*;
+        using reference = const Cell&;
+
+        Iterator(const CompactPath* path, size_t index, Cell cell) : path(path), index(index), cell(cell) {}
+
+        reference operator*() const { return cell; }
+        pointer operator->() const { return &cell; }
+
+        Iterator& operator++() {
+            if (index < path->count) {
+                uint8_t code = path->direction(index);
+                cell.r += DIRECTIONS[code][0];
+                cell.c += DIRECTIONS[code][1];
+            }
+            index++;
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator before = *this;
+            ++*this;
+            return before;
+        }
+
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+
+    private:
+        const CompactPath* path;
+        size_t index;
+        Cell cell;
+    };
+
+    Iterator begin() const { return Iterator(this, 0, origin); }
+    Iterator end() const { return Iterator(this, size(), origin); }
+
+private:
+    Cell origin = Cell(-1, -1);
+    size_t count = 0;
+    std::vector<uint8_t> packed;
+};
@@ -0,0 +1,119 @@
+/**
+ * Dungeon Pathfinder - Connectivity Labels
+ *
+ * Union-find region labeling and the key-door reachability closure.
+ */
+
+#include "connectivity.h"
+#include <utility>
+
+using namespace std;
+
+/**
+ * Helper function: Union-find over flat cell indices with path halving.
+ * Each root also carries the OR of the key masks of its members.
+ */
+struct CellUnionFind {
+    vector<int> parent;
+    vector<uint8_t> keys;
+
+    explicit CellUnionFind(size_t size) : parent(size, -1), keys(size, 0) {}
+
+    void add(int cell, uint8_t cellKeys) {
+        parent[cell] = cell;
+        keys[cell] = cellKeys;
+    }
+
+    bool contains(int cell) const { return parent[cell] != -1; }
+
+    int find(int cell) {
+        while (parent[cell] != cell) {
+            parent[cell] = parent[parent[cell]];
+            cell = parent[cell];
+        }
+        return cell;
+    }
+
+    void unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return;
+        if (b < a) swap(a, b);
+        parent[b] = a;
+        keys[a] |= keys[b];
+    }
+};
+
+/**
+ * Helper function: Key bit of a cell, 0 if it holds no key
+ */
+static uint8_t keyBit(char cell) {
+    uint8_t cls = cellClass(cell);
+    return (cls & CELL_KEY) ? static_cast<uint8_t>(1u << (cls & CELL_LETTER_MASK)) : 0;
+}
+
+ConnectivityLabels::ConnectivityLabels(const GridView& grid)
+    : rows(grid.rows), cols(grid.cols), stride(grid.stride), start(grid.start), exit(grid.exit),
+      labels(grid.size(), BLOCKED) {
+    CellUnionFind sets(grid.size());
+    vector<int> doors[6];
+
+    // Raster pass: unite each open cell with its already-visited neighbours
+    for (int r = 0; r < rows; r++) {
+        const char* row = grid.row(r);
+        for (int c = 0; c < cols; c++) {
+            const int i = grid.index(r, c);
+            const uint8_t cls = cellClass(row[c]);
+            if (cls & CELL_DOOR) doors[cls & CELL_LETTER_MASK].push_back(i);
+            if (cls & CELL_BLOCKED) continue;
+
+            sets.add(i, keyBit(row[c]));
+            if (r > 0 && sets.contains(i - stride)) sets.unite(i, i - stride);
+            if (c > 0 && sets.contains(i - 1)) sets.unite(i, i - 1);
+        }
+    }
+
+    // Dense region ids; roots are the smallest index of their set, so each
+    // root is numbered before any other member is reached
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            const int i = grid.index(r, c);
+            if (!sets.contains(i)) continue;
+            const int root = sets.find(i);
+            if (root == i) {
+                labels[i] = static_cast<int>(regionKeys.size());
+                regionKeys.push_back(sets.keys[i]);
+            } else {
+                labels[i] = labels[root];
+            }
+        }
+    }
+
+    if (start.r == -1) return;
+
+    // Key-door closure: open every door whose key S's set holds, which may
+    // merge in more keys, until nothing changes (at most one round per key)
+    const int startIdx = grid.index(start.r, start.c);
+    uint8_t opened = 0;
+    for (;;) {
+        const uint8_t newKeys = static_cast<uint8_t>(sets.keys[sets.find(startIdx)] & ~opened);
+        if (newKeys == 0) break;
+        opened |= newKeys;
+
+        for (int letter = 0; letter < 6; letter++) {
+            if (!(newKeys & (1u << letter))) continue;
+            for (int door : doors[letter]) sets.add(door, 0);
+            for (int door : doors[letter]) {
+                const int r = door / stride, c = door % stride;
+                if (r > 0 && sets.contains(door - stride)) sets.unite(door, door - stride);
+                if (r + 1 < rows && sets.contains(door + stride)) sets.unite(door, door + stride);
+                if (c > 0 && sets.contains(door - 1)) sets.unite(door, door - 1);
+                if (c + 1 < cols && sets.contains(door + 1)) sets.unite(door, door + 1);
+            }
+        }
+    }
+
+    keyClosureKeys = sets.keys[sets.find(startIdx)];
+    keyClosureExit = exit.r != -1 && sets.contains(grid.index(exit.r, exit.c)) &&
+                     sets.find(startIdx) == sets.find(grid.index(exit.r, exit.c));
+}
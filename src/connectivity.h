@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "cell.h"
+#include "grid.h"
+
+/**
+ * Connected-region labels of a dungeon, computed once with union-find so
+ * that reachability questions are O(1) afterwards.
+ *
+ * Construction makes one raster pass that unions every open cell with its
+ * upper and left neighbours (walls and doors block, as in bfsPath), then
+ * numbers the resulting regions 0..regionCount()-1. The key-door answers
+ * come from continuing the same union-find: whenever S's region holds the
+ * key to a door, that door's cells are united with their open neighbours,
+ * until no new key turns up. Keys are never used up, so this closure is
+ * exactly what the key-door BFS can reach.
+ *
+ * Costs one int per cell; start and exit are taken from the grid.
+ */
+class ConnectivityLabels {
+public:
+    static constexpr int BLOCKED = -1;
+
+    explicit ConnectivityLabels(const GridView& grid);
+
+    // Region of cell under the basic rules; BLOCKED for walls, doors and out of bounds
+    int label(Cell cell) const {
+        if (cell.r < 0 || cell.r >= rows || cell.c < 0 || cell.c >= cols) return BLOCKED;
+        return labels[cell.r * stride + cell.c];
+    }
+
+    // Whether a and b are both open and in the same basic region
+    bool connected(Cell a, Cell b) const {
+        int region = label(a);
+        return region != BLOCKED && region == label(b);
+    }
+
+    int regionCount() const { return static_cast<int>(regionKeys.size()); }
+
+    // Keys lying in region (bit i = key 'a' + i)
+    uint8_t keysIn(int region) const { return regionKeys[region]; }
+
+    // E reachable from S with doors closed, same answer as !bfsPath().empty()
+    bool exitReachable() const { return connected(start, exit); }
+
+    // Keys reachable from S with doors closed
+    uint8_t reachableKeys() const { return label(start) == BLOCKED ? 0 : regionKeys[label(start)]; }
+
+    // Keys collectable from S under the key-door rules
+    uint8_t collectableKeys() const { return keyClosureKeys; }
+
+    // E reachable under the key-door rules, same answer as !bfsPathKeys().empty()
+    bool exitReachableWithKeys() const { return keyClosureExit; }
+
+private:
+    int rows = 0;
+    int cols = 0;
+    int stride = 0;
+    Cell start;
+    Cell exit;
+    std::vector<int> labels;          // Indexed like Grid::cells
+    std::vector<uint8_t> regionKeys;  // Key mask per region
+    uint8_t keyClosureKeys = 0;
+    bool keyClosureExit = false;
+};
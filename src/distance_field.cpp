@@ -0,0 +1,271 @@
+/**
+ * Dungeon Pathfinder - Distance Fields
+ *
+ * Multi-source BFS distance / nearest-source fields, sequential and
+ * tile-parallel.
+ */
+
+#include "distance_field.h"
+#include <algorithm>
+
+using namespace std;
+
+const uint32_t DistanceField::UNREACHED;
+
+/**
+ * Helper function: (distance, source id) packed so that comparing labels
+ * compares distance first and breaks ties on the lower source id
+ */
+static inline uint64_t packLabel(uint32_t dist, uint32_t source) {
+    return (static_cast<uint64_t>(dist) << 32) | source;
+}
+
+static const uint64_t ONE_STEP = uint64_t(1) << 32;
+
+/**
+ * Helper function: Empty field (everything unreached) shaped like grid
+ */
+static DistanceField makeField(const GridView& grid) {
+    DistanceField field;
+    field.rows = grid.rows;
+    field.cols = grid.cols;
+    field.stride = grid.stride;
+    field.dist.assign(grid.size(), DistanceField::UNREACHED);
+    field.source.assign(grid.size(), DistanceField::UNREACHED);
+    return field;
+}
+
+Cell DistanceField::nextStep(Cell cell) const {
+    const int idx = index(cell.r, cell.c);
+    const uint32_t d = dist[idx];
+    if (d == 0 || d == UNREACHED) return cell;
+
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        int r = cell.r + DIRECTIONS[i][0];
+        int c = cell.c + DIRECTIONS[i][1];
+        if (r < 0 || r >= rows || c < 0 || c >= cols) continue;
+        int next = index(r, c);
+        if (dist[next] == d - 1 && source[next] == source[idx]) return Cell(r, c);
+    }
+    return cell;
+}
+
+DistanceField multiSourceDistances(const GridView& grid, const vector<Cell>& sources) {
+    DistanceField field = makeField(grid);
+    const int stride = grid.stride;
+    const char* cells = grid.cells;
+    uint32_t* dist = field.dist.data();
+    uint32_t* source = field.source.data();
+
+    vector<int> frontier;
+    frontier.reserve(grid.size());
+    for (size_t i = 0; i < sources.size(); i++) {
+        const Cell& cell = sources[i];
+        if (!grid.inBounds(cell.r, cell.c)) continue;
+        int idx = grid.index(cell.r, cell.c);
+        if (!isOpenChar(cells[idx]) || dist[idx] == 0) continue;  // Duplicates keep the lower id
+        dist[idx] = 0;
+        source[idx] = static_cast<uint32_t>(i);
+        frontier.push_back(idx);
+    }
+
+    // Plain FIFO BFS. Every cell at distance d is dequeued before any at d + 1,
+    // so a cell first reached at d + 1 can still take a lower source id from
+    // another parent at d before it is expanded itself.
+    for (size_t head = 0; head < frontier.size(); head++) {
+        const int current = frontier[head];
+        const uint32_t nextDist = dist[current] + 1;
+        const uint32_t id = source[current];
+        const int col = current % stride;
+
+        int neighbors[NUM_DIRECTIONS];
+        int count = 0;
+        if (current >= stride) neighbors[count++] = current - stride;
+        if (current + stride < grid.size()) neighbors[count++] = current + stride;
+        if (col > 0) neighbors[count++] = current - 1;
+        if (col + 1 < grid.cols) neighbors[count++] = current + 1;
+
+        for (int i = 0; i < count; i++) {
+            const int next = neighbors[i];
+            if (dist[next] == DistanceField::UNREACHED) {
+                if (!isOpenChar(cells[next])) continue;
+                dist[next] = nextDist;
+                source[next] = id;
+                frontier.push_back(next);
+            } else if (dist[next] == nextDist && source[next] > id) {
+                source[next] = id;
+            }
+        }
+    }
+
+    return field;
+}
+
+namespace {
+
+struct Seed {
+    uint64_t label;
+    int idx;
+    bool operator<(const Seed& other) const {
+        return label < other.label || (label == other.label && idx < other.idx);
+    }
+};
+
+/**
+ * Rectangle of cells [r0, r1) x [c0, c1) owned by one tile.
+ */
+struct Tile {
+    int r0, r1, c0, c1;
+};
+
+}  // namespace
+
+DistanceField multiSourceDistances(const GridView& grid, const vector<Cell>& sources,
+                                   ThreadPool& pool, int tileSize) {
+    DistanceField field = makeField(grid);
+    if (grid.rows == 0 || grid.cols == 0) return field;
+
+    tileSize = max(tileSize, 1);
+    const int stride = grid.stride;
+    const char* cells = grid.cells;
+    uint32_t* dist = field.dist.data();
+    uint32_t* source = field.source.data();
+
+    const int tileRows = (grid.rows + tileSize - 1) / tileSize;
+    const int tileCols = (grid.cols + tileSize - 1) / tileSize;
+    const int tileCount = tileRows * tileCols;
+    vector<Tile> tiles(tileCount);
+    for (int tr = 0; tr < tileRows; tr++) {
+        for (int tc = 0; tc < tileCols; tc++) {
+            tiles[tr * tileCols + tc] = Tile{tr * tileSize, min(grid.rows, (tr + 1) * tileSize),
+                                             tc * tileSize, min(grid.cols, (tc + 1) * tileSize)};
+        }
+    }
+
+    auto labelAt = [&](int idx) { return packLabel(dist[idx], source[idx]); };
+
+    vector<vector<Seed>> seeds(tileCount);
+    vector<char> borderChanged(tileCount, 0);
+    vector<vector<Seed>> queues(pool.size());
+
+    for (size_t i = 0; i < sources.size(); i++) {
+        const Cell& cell = sources[i];
+        if (!grid.inBounds(cell.r, cell.c) || !isOpenChar(grid.at(cell.r, cell.c))) continue;
+        int tile = (cell.r / tileSize) * tileCols + cell.c / tileSize;
+        seeds[tile].push_back(Seed{packLabel(0, static_cast<uint32_t>(i)), grid.index(cell.r, cell.c)});
+    }
+
+    // Propagates a tile's seeds inside the tile, visiting labels in increasing
+    // order: the sorted seeds are merged with the FIFO of cells they improved,
+    // which stays sorted because every step adds exactly ONE_STEP.
+    auto propagate = [&](int t, unsigned worker) {
+        const Tile& tile = tiles[t];
+        vector<Seed>& pending = seeds[t];
+        vector<Seed>& queue = queues[worker];
+        sort(pending.begin(), pending.end());
+        queue.clear();
+
+        auto improve = [&](int idx, uint64_t label) {
+            dist[idx] = static_cast<uint32_t>(label >> 32);
+            source[idx] = static_cast<uint32_t>(label);
+            int r = idx / stride, c = idx % stride;
+            if (r == tile.r0 || r == tile.r1 - 1 || c == tile.c0 || c == tile.c1 - 1) borderChanged[t] = 1;
+        };
+
+        size_t next = 0, head = 0;
+        while (next < pending.size() || head < queue.size()) {
+            Seed entry;
+            if (next < pending.size() && (head == queue.size() || pending[next].label <= queue[head].label)) {
+                entry = pending[next++];
+                if (entry.label >= labelAt(entry.idx)) continue;
+                improve(entry.idx, entry.label);
+            } else {
+                entry = queue[head++];
+                if (entry.label != labelAt(entry.idx)) continue;  // Improved again by a later seed
+            }
+
+            const uint64_t stepLabel = entry.label + ONE_STEP;
+            const int r = entry.idx / stride, c = entry.idx % stride;
+            int neighbors[NUM_DIRECTIONS];
+            int count = 0;
+            if (r > tile.r0) neighbors[count++] = entry.idx - stride;
+            if (r + 1 < tile.r1) neighbors[count++] = entry.idx + stride;
+            if (c > tile.c0) neighbors[count++] = entry.idx - 1;
+            if (c + 1 < tile.c1) neighbors[count++] = entry.idx + 1;
+
+            for (int i = 0; i < count; i++) {
+                int neighbor = neighbors[i];
+                if (stepLabel >= labelAt(neighbor) || !isOpenChar(cells[neighbor])) continue;
+                improve(neighbor, stepLabel);
+                queue.push_back(Seed{stepLabel, neighbor});
+            }
+        }
+        pending.clear();
+    };
+
+    // Collects labels offered across the edges shared with tiles that changed
+    // last round. Reads neighbours' cells only, so it runs while nobody writes.
+    auto pullBorders = [&](int t) {
+        const Tile& tile = tiles[t];
+        const int tr = t / tileCols, tc = t % tileCols;
+        vector<Seed>& pending = seeds[t];
+
+        auto offer = [&](int inner, int outer) {
+            if (dist[outer] == DistanceField::UNREACHED || !isOpenChar(cells[inner])) return;
+            uint64_t label = labelAt(outer) + ONE_STEP;
+            if (label < labelAt(inner)) pending.push_back(Seed{label, inner});
+        };
+
+        if (tr > 0 && borderChanged[t - tileCols]) {
+            for (int c = tile.c0; c < tile.c1; c++) offer(grid.index(tile.r0, c), grid.index(tile.r0 - 1, c));
+        }
+        if (tr + 1 < tileRows && borderChanged[t + tileCols]) {
+            for (int c = tile.c0; c < tile.c1; c++) offer(grid.index(tile.r1 - 1, c), grid.index(tile.r1, c));
+        }
+        if (tc > 0 && borderChanged[t - 1]) {
+            for (int r = tile.r0; r < tile.r1; r++) offer(grid.index(r, tile.c0), grid.index(r, tile.c0 - 1));
+        }
+        if (tc + 1 < tileCols && borderChanged[t + 1]) {
+            for (int r = tile.r0; r < tile.r1; r++) offer(grid.index(r, tile.c1 - 1), grid.index(r, tile.c1));
+        }
+    };
+
+    vector<int> active, changed, dirty;
+    vector<char> isDirty(tileCount, 0);
+    for (int t = 0; t < tileCount; t++) {
+        if (!seeds[t].empty()) active.push_back(t);
+    }
+
+    while (!active.empty()) {
+        pool.parallelFor(active.size(), [&](size_t k, unsigned worker) { propagate(active[k], worker); });
+
+        changed.clear();
+        for (int t : active) {
+            if (borderChanged[t]) changed.push_back(t);
+        }
+
+        // Neighbours of changed tiles pull from them; the outer grid border has none
+        dirty.clear();
+        for (int t : changed) {
+            const int tr = t / tileCols, tc = t % tileCols;
+            const int around[4] = {tr > 0 ? t - tileCols : -1, tr + 1 < tileRows ? t + tileCols : -1,
+                                   tc > 0 ? t - 1 : -1, tc + 1 < tileCols ? t + 1 : -1};
+            for (int u : around) {
+                if (u != -1 && !isDirty[u]) {
+                    isDirty[u] = 1;
+                    dirty.push_back(u);
+                }
+            }
+        }
+        pool.parallelFor(dirty.size(), [&](size_t k, unsigned) { pullBorders(dirty[k]); });
+
+        for (int t : changed) borderChanged[t] = 0;
+        active.clear();
+        for (int t : dirty) {
+            isDirty[t] = 0;
+            if (!seeds[t].empty()) active.push_back(t);
+        }
+    }
+
+    return field;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "cell.h"
+#include "grid.h"
+#include "thread_pool.h"
+
+/**
+ * Distance from every cell to its nearest source, under the basic-BFS rules
+ * (walls and doors block), plus which source that is. Both arrays are indexed
+ * like Grid::cells. Ties between equally near sources go to the lowest
+ * source id, so the result does not depend on how it was computed.
+ */
+struct DistanceField {
+    static const uint32_t UNREACHED = UINT32_MAX;
+
+    int rows = 0;
+    int cols = 0;
+    int stride = 0;                 // Same as the grid's stride
+    std::vector<uint32_t> dist;     // Steps to the nearest source, UNREACHED if none
+    std::vector<uint32_t> source;   // Index into sources of that source, UNREACHED if none
+
+    int index(int row, int col) const { return row * stride + col; }
+
+    uint32_t distanceAt(Cell cell) const { return dist[index(cell.r, cell.c)]; }
+    uint32_t sourceAt(Cell cell) const { return source[index(cell.r, cell.c)]; }
+
+    /**
+     * One step from cell toward its nearest source, in O(1). Returns cell
+     * itself when it is a source or cannot reach one.
+     */
+    Cell nextStep(Cell cell) const;
+};
+
+/**
+ * Multi-source BFS: the queue starts with every source at distance 0.
+ * Out-of-bounds or blocked sources are ignored (they never win a cell).
+ *
+ * @param grid Dungeon to measure
+ * @param sources Targets such as exits, or agent starts; source ids are their indices
+ * @return Dense distance and nearest-source fields
+ */
+DistanceField multiSourceDistances(const GridView& grid, const std::vector<Cell>& sources);
+
+/**
+ * Same field computed tile by tile on pool. Each round, every tile whose
+ * neighbours improved a border cell pulls the better labels across its edge
+ * and re-propagates them inside the tile; rounds repeat until no border
+ * changes. Tiles touch disjoint cells, so a round needs no locking.
+ *
+ * Mazes with long winding corridors cross tile edges often and need many
+ * rounds; open dungeons settle in a few.
+ *
+ * @param tileSize Tile edge in cells
+ */
+DistanceField multiSourceDistances(const GridView& grid, const std::vector<Cell>& sources,
+                                   ThreadPool& pool, int tileSize = 256);
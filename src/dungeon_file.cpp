@@ -0,0 +1,363 @@
+/**
+ * Dungeon Pathfinder - Binary Dungeon Files
+ *
+ * Packed 2/4-bit dungeon storage, a memory-mapped reader and a BFS that
+ * runs on the packed cells.
+ */
+
+#include "dungeon_file.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if DUNGEON_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const char FILE_MAGIC[4] = {'D', 'P', 'D', 'F'};
+static const uint32_t FILE_VERSION = 1;
+
+// Decoding table for 4-bit cells; 2-bit cells use the first three entries
+// plus the S/E rule
+static const char CELL_SYMBOLS[16] = {
+    '#', ' ', '.', 'S', 'E', 'a', 'b', 'c', 'd', 'e', 'f', 'A', 'B', 'C', 'D', 'F'
+};
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+};
+
+struct RecordHeader {
+    uint32_t rows;
+    uint32_t cols;
+    int32_t startRow, startCol;
+    int32_t exitRow, exitCol;
+    uint32_t rowBytes;
+    uint16_t poiCount;
+    uint8_t bitsPerCell;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 16, "FileHeader layout");
+static_assert(sizeof(RecordHeader) == 32, "RecordHeader layout");
+static_assert(sizeof(DungeonPoi) == 12, "DungeonPoi layout");
+
+/**
+ * Helper function: 4-bit code of a dungeon character, or -1 if it has none
+ */
+static int cellCode(char cell) {
+    const char* found = find(CELL_SYMBOLS, CELL_SYMBOLS + 16, cell);
+    return found == CELL_SYMBOLS + 16 ? -1 : static_cast<int>(found - CELL_SYMBOLS);
+}
+
+static bool isKeyOrDoor(char cell) {
+    return cellClass(cell) & (CELL_KEY | CELL_DOOR);
+}
+
+/**
+ * Helper function: A stored S or E position is either missing (-1, -1) or
+ * inside the rows x cols map
+ */
+static bool validEndpoint(int32_t row, int32_t col, uint32_t rows, uint32_t cols) {
+    if (row == -1 && col == -1) return true;
+    return row >= 0 && col >= 0 && static_cast<uint32_t>(row) < rows && static_cast<uint32_t>(col) < cols;
+}
+
+static size_t alignTo8(size_t bytes) {
+    return (bytes + 7) & ~size_t(7);
+}
+
+char PackedDungeon::at(int row, int col) const {
+    int value = code(row, col);
+    if (bitsPerCell == 2 && value == 3) {
+        return Cell(row, col) == start ? 'S' : 'E';
+    }
+    return CELL_SYMBOLS[value];
+}
+
+Grid PackedDungeon::toGrid() const {
+    Grid grid(rows, cols);
+    for (int r = 0; r < rows; r++) {
+        char* out = grid.cells.data() + static_cast<size_t>(r) * grid.stride;
+        for (int c = 0; c < cols; c++) out[c] = at(r, c);
+    }
+    grid.start = start;
+    grid.exit = exit;
+    return grid;
+}
+
+DungeonFile::~DungeonFile() {
+    close();
+}
+
+void DungeonFile::close() {
+#if DUNGEON_FILE_MMAP
+    if (base) munmap(const_cast<uint8_t*>(base), length);
+#endif
+    buffer.clear();
+    buffer.shrink_to_fit();
+    base = nullptr;
+    length = 0;
+    count = 0;
+}
+
+#if DUNGEON_FILE_MMAP
+/**
+ * Helper function: Map path read-only; returns nullptr if it can't be opened
+ * or is shorter than a file header
+ */
+static const uint8_t* mapFile(const string& path, size_t& bytes) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    bytes = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    return mapped == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(mapped);
+}
+#endif
+
+bool DungeonFile::open(const string& path) {
+    close();
+
+#if DUNGEON_FILE_MMAP
+    size_t bytes = 0;
+    const uint8_t* data = mapFile(path, bytes);
+    if (!data) return false;
+#else
+    // No mmap: read the whole file, into 8-byte words so records stay aligned
+    ifstream in(path, ios::binary | ios::ate);
+    if (!in) return false;
+    const streamoff end = in.tellg();
+    if (end < static_cast<streamoff>(sizeof(FileHeader))) return false;
+
+    size_t bytes = static_cast<size_t>(end);
+    buffer.resize((bytes + 7) / 8);
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<streamsize>(bytes))) {
+        buffer.clear();
+        return false;
+    }
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer.data());
+#endif
+
+    base = data;
+    length = bytes;
+
+    FileHeader header;
+    memcpy(&header, data, sizeof(header));
+    bool ok = memcmp(header.magic, FILE_MAGIC, 4) == 0 && header.version == FILE_VERSION &&
+              header.count <= (bytes - sizeof(FileHeader)) / sizeof(uint64_t);
+    if (!ok) {
+        close();
+        return false;
+    }
+
+    count = static_cast<size_t>(header.count);
+    return true;
+}
+
+PackedDungeon DungeonFile::dungeon(size_t i) const {
+    PackedDungeon view;
+    if (i >= count) return view;
+
+    uint64_t offset;
+    memcpy(&offset, base + sizeof(FileHeader) + i * sizeof(uint64_t), sizeof(offset));
+    if (offset % 8 != 0 || offset > length || length - offset < sizeof(RecordHeader)) return view;
+
+    RecordHeader header;
+    memcpy(&header, base + offset, sizeof(header));
+    if (header.bitsPerCell != 2 && header.bitsPerCell != 4) return view;
+    if (header.rowBytes != (static_cast<uint64_t>(header.cols) * header.bitsPerCell + 7) / 8) return view;
+    if (header.rows > 0x7FFFFFFF || header.cols > 0x7FFFFFFF) return view;
+    if (!validEndpoint(header.startRow, header.startCol, header.rows, header.cols) ||
+        !validEndpoint(header.exitRow, header.exitCol, header.rows, header.cols)) {
+        return view;
+    }
+
+    size_t poiBytes = static_cast<size_t>(header.poiCount) * sizeof(DungeonPoi);
+    size_t cellBytes = static_cast<size_t>(header.rows) * header.rowBytes;
+    size_t available = length - offset - sizeof(RecordHeader);
+    if (poiBytes > available || cellBytes > available - poiBytes) return view;
+
+    const uint8_t* record = base + offset + sizeof(RecordHeader);
+    view.rows = static_cast<int>(header.rows);
+    view.cols = static_cast<int>(header.cols);
+    view.bitsPerCell = header.bitsPerCell;
+    view.rowBytes = static_cast<int>(header.rowBytes);
+    view.start = Cell(header.startRow, header.startCol);
+    view.exit = Cell(header.exitRow, header.exitCol);
+    view.pois = reinterpret_cast<const DungeonPoi*>(record);
+    view.poiCount = header.poiCount;
+    view.data = record + poiBytes;
+    return view;
+}
+
+/**
+ * Helper function: Pack one dungeon into a record; returns false if a cell
+ * has no code or there are too many keys and doors for the header
+ */
+static bool packDungeon(const Grid& grid, vector<uint8_t>& record) {
+    vector<DungeonPoi> pois;
+    int starts = 0, exits = 0;
+    for (int r = 0; r < grid.rows; r++) {
+        for (int c = 0; c < grid.cols; c++) {
+            char cell = grid.at(r, c);
+            if (cellCode(cell) < 0) return false;
+            if (cell == 'S') starts++;
+            if (cell == 'E') exits++;
+            if (isKeyOrDoor(cell)) {
+                DungeonPoi poi = {static_cast<uint32_t>(r), static_cast<uint32_t>(c), cell, {0, 0, 0}};
+                pois.push_back(poi);
+            }
+        }
+    }
+    if (pois.size() > 0xFFFF) return false;
+
+    // 2-bit cells can only tell S and E apart through the header positions
+    RecordHeader header = {};
+    header.bitsPerCell = (pois.empty() && starts <= 1 && exits <= 1) ? 2 : 4;
+    header.rows = static_cast<uint32_t>(grid.rows);
+    header.cols = static_cast<uint32_t>(grid.cols);
+    header.startRow = grid.start.r;
+    header.startCol = grid.start.c;
+    header.exitRow = grid.exit.r;
+    header.exitCol = grid.exit.c;
+    header.rowBytes = static_cast<uint32_t>((static_cast<size_t>(grid.cols) * header.bitsPerCell + 7) / 8);
+    header.poiCount = static_cast<uint16_t>(pois.size());
+
+    size_t poiBytes = pois.size() * sizeof(DungeonPoi);
+    size_t cellBytes = static_cast<size_t>(grid.rows) * header.rowBytes;
+    record.assign(alignTo8(sizeof(header) + poiBytes + cellBytes), 0);
+    memcpy(record.data(), &header, sizeof(header));
+    if (poiBytes) memcpy(record.data() + sizeof(header), pois.data(), poiBytes);
+
+    uint8_t* cells = record.data() + sizeof(header) + poiBytes;
+    for (int r = 0; r < grid.rows; r++) {
+        uint8_t* row = cells + static_cast<size_t>(r) * header.rowBytes;
+        for (int c = 0; c < grid.cols; c++) {
+            int value = cellCode(grid.at(r, c));
+            if (header.bitsPerCell == 2 && value == 4) value = 3;  // 'E' shares the endpoint code
+            int bit = c * header.bitsPerCell;
+            row[bit / 8] |= static_cast<uint8_t>(value << (bit % 8));
+        }
+    }
+    return true;
+}
+
+bool writeDungeonFile(const string& path, const Grid* dungeons, size_t count) {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) return false;
+
+    FileHeader header;
+    memcpy(header.magic, FILE_MAGIC, 4);
+    header.version = FILE_VERSION;
+    header.count = count;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Records are written one at a time, so the directory is filled in
+    // afterwards instead of packing everything up front
+    vector<uint64_t> offsets(count, 0);
+    out.write(reinterpret_cast<const char*>(offsets.data()), count * sizeof(uint64_t));
+
+    uint64_t offset = alignTo8(sizeof(header) + count * sizeof(uint64_t));
+    static const char padding[8] = {0};
+    out.write(padding, offset - (sizeof(header) + count * sizeof(uint64_t)));
+
+    vector<uint8_t> record;
+    for (size_t i = 0; i < count; i++) {
+        if (!packDungeon(dungeons[i], record)) return false;
+        offsets[i] = offset;
+        out.write(reinterpret_cast<const char*>(record.data()), record.size());
+        offset += record.size();
+    }
+
+    out.seekp(sizeof(header));
+    out.write(reinterpret_cast<const char*>(offsets.data()), count * sizeof(uint64_t));
+    return static_cast<bool>(out);
+}
+
+bool writeDungeonFile(const string& path, const vector<Grid>& dungeons) {
+    return writeDungeonFile(path, dungeons.data(), dungeons.size());
+}
+
+std::vector<Cell> bfsPath(const PackedDungeon& dungeon, SolverContext& ctx) {
+    ctx.explored = 0;
+    const int rows = dungeon.rows;
+    const int cols = dungeon.cols;
+    if (!dungeon.valid() || dungeon.start.r < 0 || dungeon.start.r >= rows || dungeon.start.c < 0 ||
+        dungeon.start.c >= cols || dungeon.exit.r < 0 || dungeon.exit.r >= rows ||
+        dungeon.exit.c < 0 || dungeon.exit.c >= cols) {
+        return vector<Cell>();  // Invalid dungeon
+    }
+
+    // Bit i set when code i is passable under the basic rules: everything
+    // but walls, and for 4-bit cells also everything but doors
+    const unsigned passMask = dungeon.bitsPerCell == 2 ? 0xEu : 0x7FEu;
+    auto passable = [&](int row, int col) { return (passMask >> dungeon.code(row, col)) & 1; };
+
+    // Same flat BFS as bfsPath(Grid), indexed r * cols + c
+    const int total = rows * cols;
+    const int startIdx = dungeon.start.r * cols + dungeon.start.c;
+    const int exitIdx = dungeon.exit.r * cols + dungeon.exit.c;
+    vector<int>& frontier = ctx.frontier;
+    vector<int>& parent = ctx.parent;
+    if (frontier.size() < static_cast<size_t>(total)) frontier.resize(total);
+    if (parent.size() < static_cast<size_t>(total)) parent.resize(total);
+    const uint32_t seen = ctx.beginSearch(total);
+    uint32_t* mark = ctx.mark.data();
+    int head = 0, tail = 0;
+
+    frontier[tail++] = startIdx;
+    mark[startIdx] = seen;
+    parent[startIdx] = -1;
+
+    while (head < tail) {
+        int current = frontier[head++];
+
+        if (current == exitIdx) {
+            ctx.explored = head;
+            vector<Cell> path;
+            for (int idx = current; idx != -1; idx = parent[idx]) path.push_back(Cell(idx / cols, idx % cols));
+            reverse(path.begin(), path.end());
+            return path;
+        }
+
+        int row = current / cols;
+        int col = current - row * cols;
+        int neighbors[NUM_DIRECTIONS];
+        Cell cells[NUM_DIRECTIONS];
+        int count = 0;
+
+        // Same order as DIRECTIONS: up, down, left, right
+        if (row > 0) { cells[count] = Cell(row - 1, col); neighbors[count++] = current - cols; }
+        if (row + 1 < rows) { cells[count] = Cell(row + 1, col); neighbors[count++] = current + cols; }
+        if (col > 0) { cells[count] = Cell(row, col - 1); neighbors[count++] = current - 1; }
+        if (col + 1 < cols) { cells[count] = Cell(row, col + 1); neighbors[count++] = current + 1; }
+
+        for (int i = 0; i < count; i++) {
+            int next = neighbors[i];
+            if (mark[next] != seen && passable(cells[i].r, cells[i].c)) {
+                mark[next] = seen;
+                parent[next] = current;
+                frontier[tail++] = next;
+            }
+        }
+    }
+
+    ctx.explored = head;
+    return vector<Cell>();
+}
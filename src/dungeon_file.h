@@ -0,0 +1,134 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "cell.h"
+#include "grid.h"
+#include "solver.h"
+
+// POSIX targets map files with mmap; elsewhere DungeonFile reads them into memory
+#ifndef DUNGEON_FILE_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define DUNGEON_FILE_MMAP 1
+#else
+#define DUNGEON_FILE_MMAP 0
+#endif
+#endif
+
+/**
+ * Compact binary dungeon file ("DPDF", version 1). All integers are little
+ * endian; every record starts on an 8-byte boundary.
+ *
+ *   File header   char magic[4] = "DPDF", uint32 version, uint64 count
+ *   Directory     uint64 offset[count]  (byte offset of each record)
+ *   Record        rows, cols, start row/col, exit row/col, rowBytes (32 bit),
+ *                 uint16 poiCount, uint8 bitsPerCell, uint8 reserved,
+ *                 then poiCount DungeonPoi entries (keys and doors),
+ *                 then rows * rowBytes bytes of packed cells
+ *
+ * Cells are packed low bits first, 2 or 4 bits each:
+ *   4-bit  0 '#'  1 ' '  2 '.'  3 'S'  4 'E'  5-10 'a'-'f'  11-15 'A' 'B' 'C' 'D' 'F'
+ *   2-bit  0 '#'  1 ' '  2 '.'  3 'S' or 'E' (whichever the header says is there)
+ * The writer picks 2 bits for dungeons without keys or doors, which covers
+ * every map from generateDungeon, so a 4k x 4k maze takes 4 MB on disk.
+ */
+struct DungeonPoi {
+    uint32_t row;
+    uint32_t col;
+    char symbol;        // 'a'-'f' or 'A'-'F'
+    uint8_t reserved[3];
+};
+
+/**
+ * Read-only view of one dungeon inside a mapped DungeonFile. Holds pointers
+ * into the mapping, so it is only valid while the file stays open.
+ */
+struct PackedDungeon {
+    int rows = 0;
+    int cols = 0;
+    int bitsPerCell = 0;            // 2 or 4; 0 for an invalid record
+    int rowBytes = 0;               // Bytes per packed row
+    Cell start = Cell(-1, -1);
+    Cell exit = Cell(-1, -1);
+    const DungeonPoi* pois = nullptr;
+    int poiCount = 0;
+    const uint8_t* data = nullptr;  // rows * rowBytes packed cells
+
+    bool valid() const { return bitsPerCell != 0; }
+
+    // Cell code at (row, col), see the table above
+    int code(int row, int col) const {
+        int bit = col * bitsPerCell;
+        return (data[static_cast<size_t>(row) * rowBytes + bit / 8] >> (bit % 8)) & ((1 << bitsPerCell) - 1);
+    }
+
+    // Decoded dungeon character at (row, col)
+    char at(int row, int col) const;
+
+    /**
+     * Unpacks into a flat Grid, for the solvers that need key and door cells.
+     */
+    Grid toGrid() const;
+};
+
+/**
+ * Memory-mapped dungeon file. open() maps the whole file read-only and checks
+ * only the file header and directory, so opening a multi-GB corpus costs a
+ * few page faults; records are validated and paged in when first accessed.
+ * Uses POSIX mmap where available (DUNGEON_FILE_MMAP); other platforms read
+ * the whole file into memory instead, with the same interface.
+ */
+class DungeonFile {
+public:
+    DungeonFile() = default;
+    ~DungeonFile();
+
+    DungeonFile(const DungeonFile&) = delete;
+    DungeonFile& operator=(const DungeonFile&) = delete;
+
+    /**
+     * Maps path, replacing any file already open.
+     *
+     * @return false if the file can't be mapped or isn't a valid DPDF file
+     */
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return base != nullptr; }
+
+    // Number of dungeons in the file
+    size_t size() const { return count; }
+
+    /**
+     * Zero-copy view of dungeon i. Returns an invalid view (valid() == false)
+     * if i is out of range, the record runs past the end of the file, or its
+     * S or E position lies outside the map.
+     */
+    PackedDungeon dungeon(size_t i) const;
+
+private:
+    const uint8_t* base = nullptr;
+    size_t length = 0;
+    std::vector<uint64_t> buffer;   // File contents when not memory-mapped
+    size_t count = 0;
+};
+
+/**
+ * Writes dungeons to path in the format above.
+ *
+ * @return false if the file can't be written or a dungeon contains a
+ *         character outside the 4-bit table
+ */
+bool writeDungeonFile(const std::string& path, const Grid* dungeons, size_t count);
+bool writeDungeonFile(const std::string& path, const std::vector<Grid>& dungeons);
+
+/**
+ * Basic BFS (doors are walls) run directly on the packed cells, with no
+ * unpacking. Matches bfsPath(dungeon.toGrid(), ctx).
+ *
+ * @param dungeon Valid view from an open DungeonFile
+ * @param ctx Scratch buffers; ctx.explored is set to the cells expanded
+ * @return Vector of Cell coordinates from S to E, or empty if no path exists
+ */
+std::vector<Cell> bfsPath(const PackedDungeon& dungeon, SolverContext& ctx);
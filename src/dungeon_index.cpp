@@ -0,0 +1,322 @@
+/**
+ * Dungeon Pathfinder - Dungeon Index
+ *
+ * Precomputed connectivity and tree-distance index for repeated queries
+ * on a static dungeon.
+ */
+
+#include "dungeon_index.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+static const uint32_t UNREACHED = UINT32_MAX;
+
+/**
+ * Helper function: BFS step counts from source over open cells, UNREACHED
+ * for everything it cannot reach. queue ends up holding the reached cells in
+ * BFS order, so its last element is one of the farthest from source.
+ */
+static void landmarkDistances(const GridView& grid, int source, uint32_t* dist, vector<int>& queue) {
+    fill(dist, dist + grid.size(), UNREACHED);
+    queue.clear();
+    queue.push_back(source);
+    dist[source] = 0;
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        int current = queue[head];
+        int col = current % grid.stride;
+        int neighbors[NUM_DIRECTIONS];
+        int count = 0;
+
+        if (current >= grid.stride) neighbors[count++] = current - grid.stride;
+        if (current + grid.stride < grid.size()) neighbors[count++] = current + grid.stride;
+        if (col > 0) neighbors[count++] = current - 1;
+        if (col + 1 < grid.cols) neighbors[count++] = current + 1;
+
+        for (int i = 0; i < count; i++) {
+            int next = neighbors[i];
+            if (dist[next] != UNREACHED || !isOpenChar(grid.cells[next])) continue;
+            dist[next] = dist[current] + 1;
+            queue.push_back(next);
+        }
+    }
+}
+
+DungeonIndex::DungeonIndex(const GridView& grid, int landmarks)
+    : grid(grid),
+      component(grid.size(), -1),
+      parent(grid.size(), -1),
+      depth(grid.size(), 0),
+      chainHead(grid.size(), -1) {
+    const int stride = grid.stride;
+    const char* cells = grid.cells;
+
+    // BFS order over every open cell, component by component. Parents always
+    // appear before their children, which the passes below rely on.
+    vector<int> order;
+    order.reserve(grid.size());
+    long long openCells = 0, edges = 0;
+    int components = 0;
+    int largestRoot = -1;
+    size_t largestSize = 0;
+
+    for (int r = 0; r < grid.rows; r++) {
+        for (int c = 0; c < grid.cols; c++) {
+            int root = grid.index(r, c);
+            if (!isOpenChar(cells[root])) continue;
+
+            openCells++;
+            if (c + 1 < grid.cols && isOpenChar(cells[root + 1])) edges++;
+            if (r + 1 < grid.rows && isOpenChar(cells[root + stride])) edges++;
+
+            if (component[root] != -1) continue;
+
+            const size_t first = order.size();
+            size_t head = first;
+            order.push_back(root);
+            component[root] = components;
+
+            while (head < order.size()) {
+                int current = order[head++];
+                int col = current % stride;
+                int neighbors[NUM_DIRECTIONS];
+                int count = 0;
+
+                if (current >= stride) neighbors[count++] = current - stride;
+                if (current + stride < grid.size()) neighbors[count++] = current + stride;
+                if (col > 0) neighbors[count++] = current - 1;
+                if (col + 1 < grid.cols) neighbors[count++] = current + 1;
+
+                for (int i = 0; i < count; i++) {
+                    int next = neighbors[i];
+                    if (component[next] != -1 || !isOpenChar(cells[next])) continue;
+                    component[next] = components;
+                    parent[next] = current;
+                    depth[next] = depth[current] + 1;
+                    order.push_back(next);
+                }
+            }
+            components++;
+
+            if (order.size() - first > largestSize) {
+                largestSize = order.size() - first;
+                largestRoot = root;
+            }
+        }
+    }
+
+    // A forest has exactly one edge fewer than cells per component
+    tree = (edges == openCells - components);
+    if (!tree) {
+        buildLandmarks(landmarks, largestRoot);
+        return;
+    }
+
+    // Heavy-light decomposition: subtree sizes bottom-up, then each cell
+    // continues its parent's chain if it is the parent's largest child
+    vector<int> subtree(grid.size(), 1);
+    vector<int> heavy(grid.size(), -1);
+    for (size_t i = order.size(); i-- > 0;) {
+        int cell = order[i];
+        int up = parent[cell];
+        if (up == -1) continue;
+        subtree[up] += subtree[cell];
+        if (heavy[up] == -1 || subtree[cell] > subtree[heavy[up]]) heavy[up] = cell;
+    }
+    for (int cell : order) {
+        int up = parent[cell];
+        chainHead[cell] = (up != -1 && heavy[up] == cell) ? chainHead[up] : cell;
+    }
+}
+
+/**
+ * Helper function: Farthest-first landmarks in the component of root. The
+ * first is the far end of a BFS from root, each next one the member whose
+ * nearest landmark so far is farthest away, which spreads them to the
+ * extremes where their bounds are tightest.
+ */
+void DungeonIndex::buildLandmarks(int count, int root) {
+    if (count <= 0 || root == -1) return;
+
+    const size_t size = grid.size();
+    vector<int> queue;
+    landmarkDist.assign(static_cast<size_t>(count) * size, UNREACHED);
+    landmarkDistances(grid, root, landmarkDist.data(), queue);
+    const vector<int> members = queue;
+    int next = queue.back();
+
+    vector<uint32_t> nearest(size, UNREACHED);
+    while (landmarkCount < count) {
+        uint32_t* dist = landmarkDist.data() + static_cast<size_t>(landmarkCount) * size;
+        landmarkDistances(grid, next, dist, queue);
+        landmarkCount++;
+
+        uint32_t farthest = 0;
+        for (int cell : members) {
+            nearest[cell] = min(nearest[cell], dist[cell]);
+            if (nearest[cell] > farthest) {
+                farthest = nearest[cell];
+                next = cell;
+            }
+        }
+        if (farthest == 0) break;  // Every member is already a landmark
+    }
+    landmarkDist.resize(static_cast<size_t>(landmarkCount) * size);
+}
+
+/**
+ * Helper function: A* from from to to, leaving steps in ctx.dist and the
+ * search tree in ctx.parent. The bound is the larger of the Manhattan
+ * distance and every landmark's |d(L, to) - d(L, v)|. On a grid each term
+ * changes by exactly 1 per step and all share one parity, so f = g + h
+ * stays the same or grows by 2 and the two-bucket open list of astarPath
+ * still applies.
+ */
+bool DungeonIndex::landmarkSearch(int from, int to, SolverContext& ctx) const {
+    const int stride = grid.stride;
+    const size_t size = grid.size();
+    const int toRow = to / stride, toCol = to % stride;
+
+    auto heuristic = [&](int idx) {
+        int h = abs(idx / stride - toRow) + abs(idx % stride - toCol);
+        for (int k = 0; k < landmarkCount; k++) {
+            const uint32_t* dist = landmarkDist.data() + static_cast<size_t>(k) * size;
+            if (dist[to] == UNREACHED) continue;  // Landmark in another component
+            h = max(h, abs(static_cast<int>(dist[to]) - static_cast<int>(dist[idx])));
+        }
+        return h;
+    };
+
+    vector<int>& parent = ctx.parent;
+    vector<int>& g = ctx.dist;
+    if (parent.size() < size) parent.resize(size);
+    if (g.size() < size) g.resize(size);
+    const uint32_t OPEN = ctx.beginSearch(size, 2), CLOSED = OPEN + 1;
+    uint32_t* state = ctx.mark.data();
+
+    vector<int>& current = ctx.frontier;
+    vector<int>& next = ctx.backFrontier;
+    current.clear();
+    next.clear();
+
+    state[from] = OPEN;
+    parent[from] = -1;
+    g[from] = 0;
+    int f = heuristic(from);
+    current.push_back(from);
+
+    while (!current.empty() || !next.empty()) {
+        if (current.empty()) {
+            swap(current, next);
+            f += 2;
+        }
+
+        int node = current.back();
+        current.pop_back();
+        if (state[node] == CLOSED) continue;  // Stale duplicate entry
+        if (g[node] + heuristic(node) != f) continue;  // Superseded by a shorter g
+
+        state[node] = CLOSED;
+        ctx.explored++;
+        if (node == to) return true;
+
+        int col = node % stride;
+        int neighbors[NUM_DIRECTIONS];
+        int count = 0;
+
+        if (node >= stride) neighbors[count++] = node - stride;
+        if (node + stride < grid.size()) neighbors[count++] = node + stride;
+        if (col > 0) neighbors[count++] = node - 1;
+        if (col + 1 < grid.cols) neighbors[count++] = node + 1;
+
+        for (int i = 0; i < count; i++) {
+            int neighbor = neighbors[i];
+            if (state[neighbor] == CLOSED || !isOpenChar(grid.cells[neighbor])) continue;
+
+            int newG = g[node] + 1;
+            if (state[neighbor] == OPEN && g[neighbor] <= newG) continue;
+
+            state[neighbor] = OPEN;
+            g[neighbor] = newG;
+            parent[neighbor] = node;
+            (newG + heuristic(neighbor) == f ? current : next).push_back(neighbor);
+        }
+    }
+    return false;
+}
+
+bool DungeonIndex::validCell(Cell cell) const {
+    return grid.inBounds(cell.r, cell.c) && component[grid.index(cell.r, cell.c)] != -1;
+}
+
+bool DungeonIndex::connected(Cell a, Cell b) const {
+    return validCell(a) && validCell(b) &&
+           component[grid.index(a.r, a.c)] == component[grid.index(b.r, b.c)];
+}
+
+/**
+ * Helper function: LCA by hopping chain heads; O(log n) hops since each
+ * light edge at least halves the remaining subtree size
+ */
+int DungeonIndex::lowestCommonAncestor(int a, int b) const {
+    while (chainHead[a] != chainHead[b]) {
+        if (depth[chainHead[a]] > depth[chainHead[b]]) {
+            a = parent[chainHead[a]];
+        } else {
+            b = parent[chainHead[b]];
+        }
+    }
+    return depth[a] < depth[b] ? a : b;
+}
+
+int DungeonIndex::distance(Cell a, Cell b, SolverContext& ctx) const {
+    ctx.explored = 0;
+    if (!connected(a, b)) return -1;
+
+    int ia = grid.index(a.r, a.c);
+    int ib = grid.index(b.r, b.c);
+    if (tree) return depth[ia] + depth[ib] - 2 * depth[lowestCommonAncestor(ia, ib)];
+    return landmarkSearch(ia, ib, ctx) ? ctx.dist[ib] : -1;
+}
+
+int DungeonIndex::distance(Cell a, Cell b) const {
+    SolverContext ctx;
+    return distance(a, b, ctx);
+}
+
+vector<Cell> DungeonIndex::path(Cell a, Cell b, SolverContext& ctx) const {
+    ctx.explored = 0;
+    if (!connected(a, b)) return vector<Cell>();
+
+    int ia = grid.index(a.r, a.c);
+    int ib = grid.index(b.r, b.c);
+    if (!tree) {
+        if (!landmarkSearch(ia, ib, ctx)) return vector<Cell>();
+        vector<Cell> route;
+        route.reserve(ctx.dist[ib] + 1);
+        for (int idx = ib; idx != -1; idx = ctx.parent[idx]) route.push_back(grid.cellAt(idx));
+        reverse(route.begin(), route.end());
+        return route;
+    }
+
+    int meet = lowestCommonAncestor(ia, ib);
+
+    // a up to the meeting cell, then b's climb in reverse
+    vector<Cell> route;
+    route.reserve(depth[ia] + depth[ib] - 2 * depth[meet] + 1);
+    for (int idx = ia; idx != meet; idx = parent[idx]) route.push_back(grid.cellAt(idx));
+    route.push_back(grid.cellAt(meet));
+
+    size_t climbStart = route.size();
+    for (int idx = ib; idx != meet; idx = parent[idx]) route.push_back(grid.cellAt(idx));
+    reverse(route.begin() + climbStart, route.end());
+
+    return route;
+}
+
+vector<Cell> DungeonIndex::path(Cell a, Cell b) const {
+    SolverContext ctx;
+    return path(a, b, ctx);
+}
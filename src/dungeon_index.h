@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "cell.h"
+#include "grid.h"
+#include "solver.h"
+
+/**
+ * Query index built once per static dungeon, for answering many basic-BFS
+ * queries (doors are walls) between arbitrary endpoints.
+ *
+ * Construction labels connected components and roots a BFS spanning tree in
+ * each one. When the open cells form a tree, which is always the case for
+ * perfect mazes from generateDungeon(rows, cols, 0), the spanning tree is the
+ * dungeon itself, and a heavy-light decomposition of it answers exact distance
+ * queries in O(log n) with O(n) memory.
+ *
+ * Dungeons with loops (any roomRate > 0) get O(1) rejection of disconnected
+ * pairs and an ALT search for the rest: BFS distance fields from a few
+ * landmarks spread over the largest component, picked farthest-first, give
+ * the lower bound |d(L, b) - d(L, v)| for every landmark L. A* guided by the
+ * best of those bounds and the Manhattan distance stays exact but expands
+ * far fewer cells than a BFS. Costs one uint32_t per cell per landmark.
+ */
+class DungeonIndex {
+public:
+    /**
+     * Builds the index in O(rows * cols), plus one BFS per landmark when the
+     * dungeon has loops. The grid must outlive the index.
+     *
+     * @param landmarks Distance fields kept for dungeons with loops
+     */
+    explicit DungeonIndex(const GridView& grid, int landmarks = 4);
+
+    // True when every component is a tree, so distance()/path() never search
+    bool isTree() const { return tree; }
+
+    // True when both cells are open and in the same connected component
+    bool connected(Cell a, Cell b) const;
+
+    /**
+     * Number of steps on a shortest path from a to b, or -1 if unreachable.
+     * O(log n) on trees; otherwise an ALT search using ctx as scratch.
+     */
+    int distance(Cell a, Cell b, SolverContext& ctx) const;
+    int distance(Cell a, Cell b) const;
+
+    /**
+     * Shortest path from a to b (inclusive), or empty if unreachable.
+     * On trees this walks up to the lowest common ancestor with no search.
+     * ctx.explored counts the cells the ALT search expanded (0 on trees).
+     */
+    std::vector<Cell> path(Cell a, Cell b, SolverContext& ctx) const;
+    std::vector<Cell> path(Cell a, Cell b) const;
+
+private:
+    int lowestCommonAncestor(int a, int b) const;
+    bool validCell(Cell cell) const;
+    void buildLandmarks(int count, int root);
+    bool landmarkSearch(int from, int to, SolverContext& ctx) const;
+
+    const GridView grid;            // Copied view; the viewed storage must outlive the index
+    bool tree = true;
+    std::vector<int> component;   // Component id per cell, -1 for blocked cells
+    std::vector<int> parent;      // Spanning-tree parent, -1 at each root
+    std::vector<int> depth;       // Depth below the component root
+    std::vector<int> chainHead;   // Top cell of the heavy chain containing the cell
+    int landmarkCount = 0;
+    std::vector<uint32_t> landmarkDist;  // landmarkCount fields of grid.size() steps each
+};
@@ -0,0 +1,200 @@
+/**
+ * Dungeon Pathfinder - ASCII Dungeon Streams
+ *
+ * Chunked text reader and buffered writer for the printDungeon format.
+ */
+
+#include "dungeon_text.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+DungeonReader::DungeonReader(istream& in, size_t bufferSize)
+    : in(in), buffer(max<size_t>(bufferSize, 1)) {}
+
+/**
+ * Helper function: Move unconsumed bytes to the front of the buffer (growing
+ * it when a single line fills it) and read the next chunk behind them
+ */
+bool DungeonReader::fill() {
+    if (eof) return false;
+
+    if (begin > 0) {
+        memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    if (end == buffer.size()) buffer.resize(buffer.size() * 2);
+
+    in.read(buffer.data() + end, static_cast<streamsize>(buffer.size() - end));
+    size_t got = static_cast<size_t>(in.gcount());
+    end += got;
+    if (got == 0 || !in) eof = true;
+    return got > 0;
+}
+
+/**
+ * Helper function: Next line without its "\n" or "\r\n". The pointer is
+ * valid until the following call; returns false at end of input.
+ */
+bool DungeonReader::nextLine(const char*& line, size_t& length) {
+    size_t scanned = begin;
+    while (true) {
+        const char* found = static_cast<const char*>(
+            memchr(buffer.data() + scanned, '\n', end - scanned));
+        if (found) {
+            line = buffer.data() + begin;
+            length = static_cast<size_t>(found - line);
+            begin += length + 1;
+            break;
+        }
+
+        scanned = end - begin;  // Offset of the unsearched tail after fill() compacts
+        if (!fill()) {
+            if (begin == end) return false;
+            line = buffer.data() + begin;  // Last line without a newline
+            length = end - begin;
+            begin = end;
+            break;
+        }
+        scanned += begin;
+    }
+
+    if (length > 0 && line[length - 1] == '\r') length--;
+    return true;
+}
+
+bool DungeonReader::next(Grid& out, string* title) {
+    const char* line;
+    size_t length = 0;
+
+    do {
+        if (!nextLine(line, length)) return false;
+    } while (length == 0);
+
+    if (title) title->clear();
+    if (line[length - 1] == ':') {
+        if (title) title->assign(line, length - 1);
+        if (!nextLine(line, length)) length = 0;
+    }
+
+    out.rows = 0;
+    out.cols = static_cast<int>(length);
+    out.stride = out.cols;
+    out.cells.clear();
+
+    while (length > 0) {
+        size_t offset = out.cells.size();
+        out.cells.resize(offset + out.cols, '#');
+        memcpy(out.cells.data() + offset, line, min(length, static_cast<size_t>(out.cols)));
+        out.rows++;
+        if (!nextLine(line, length)) break;
+    }
+
+    out.locateEndpoints();
+    return true;
+}
+
+DungeonWriter::DungeonWriter(ostream& out, size_t bufferSize)
+    : out(out), bufferSize(max<size_t>(bufferSize, 1)) {
+    buffer.reserve(this->bufferSize);
+}
+
+DungeonWriter::~DungeonWriter() {
+    flush();
+}
+
+void DungeonWriter::append(const char* data, size_t length) {
+    if (buffer.size() + length > bufferSize && !buffer.empty()) {
+        out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+        buffer.clear();
+    }
+    buffer.append(data, length);
+}
+
+void DungeonWriter::flush() {
+    if (!buffer.empty()) {
+        out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+        buffer.clear();
+    }
+    out.flush();
+}
+
+/**
+ * Helper function: Optional "title:" line
+ */
+void DungeonWriter::appendTitle(const string& title) {
+    if (!title.empty()) {
+        append(title.data(), title.size());
+        append(":\n", 2);
+    }
+}
+
+void DungeonWriter::write(const GridView& dungeon, const string& title) {
+    appendTitle(title);
+    for (int r = 0; r < dungeon.rows; r++) {
+        append(dungeon.row(r), dungeon.cols);
+        append("\n", 1);
+    }
+    append("\n", 1);
+}
+
+void DungeonWriter::write(const vector<string>& dungeon, const string& title) {
+    appendTitle(title);
+    for (const string& row : dungeon) {
+        append(row.data(), row.size());
+        append("\n", 1);
+    }
+    append("\n", 1);
+}
+
+/**
+ * Helper function: Path cells in row-major order, so each row's cells are
+ * one contiguous run
+ */
+static vector<Cell> sortedByRow(const vector<Cell>& path) {
+    vector<Cell> sorted = path;
+    sort(sorted.begin(), sorted.end(), [](const Cell& a, const Cell& b) {
+        return a.r != b.r ? a.r < b.r : a.c < b.c;
+    });
+    return sorted;
+}
+
+/**
+ * Helper function: Appends row r and overwrites its path cells in the output
+ * buffer. append() leaves a whole row at the end of the buffer, so the
+ * patches never touch bytes already handed to the stream. next walks sorted.
+ */
+void DungeonWriter::appendRowWithPath(int r, const char* row, size_t length, const vector<Cell>& sorted,
+                                      size_t& next) {
+    append(row, length);
+    char* written = &buffer[buffer.size() - length];
+    for (; next < sorted.size() && sorted[next].r <= r; next++) {
+        const Cell& cell = sorted[next];
+        if (cell.r < r || cell.c < 0 || static_cast<size_t>(cell.c) >= length) continue;
+        char& current = written[cell.c];
+        if (current != 'S' && current != 'E') current = '*';
+    }
+    append("\n", 1);
+}
+
+void DungeonWriter::writeWithPath(const GridView& dungeon, const vector<Cell>& path, const string& title) {
+    const vector<Cell> sorted = sortedByRow(path);
+    size_t next = 0;
+    appendTitle(title);
+    for (int r = 0; r < dungeon.rows; r++) {
+        appendRowWithPath(r, dungeon.row(r), dungeon.cols, sorted, next);
+    }
+    append("\n", 1);
+}
+
+void DungeonWriter::writeWithPath(const vector<string>& dungeon, const vector<Cell>& path, const string& title) {
+    const vector<Cell> sorted = sortedByRow(path);
+    size_t next = 0;
+    appendTitle(title);
+    for (size_t r = 0; r < dungeon.size(); r++) {
+        appendRowWithPath(static_cast<int>(r), dungeon[r].data(), dungeon[r].size(), sorted, next);
+    }
+    append("\n", 1);
+}
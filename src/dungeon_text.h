@@ -0,0 +1,93 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+#include "cell.h"
+#include "grid.h"
+
+/**
+ * Streaming reader for ASCII dungeons in the printDungeon format: each
+ * dungeon is a block of consecutive non-empty lines, optionally preceded by
+ * a "Title:" line, and blocks are separated by one or more blank lines.
+ *
+ * Input is pulled in large chunks and each row is copied straight into the
+ * Grid's flat buffer, so no per-row strings are built. As in
+ * Grid(vector<string>), the first row sets the width, shorter rows are
+ * padded with walls and longer rows are cut. Trailing '\r' is dropped, so
+ * CRLF files read the same as LF files.
+ */
+class DungeonReader {
+public:
+    /**
+     * @param in Stream to read; must outlive the reader
+     * @param bufferSize Bytes read from the stream per chunk
+     */
+    explicit DungeonReader(std::istream& in, size_t bufferSize = 1 << 20);
+
+    /**
+     * Reads the next dungeon into out (reusing its storage).
+     *
+     * @param out Receives the dungeon, with start/exit located
+     * @param title If not null, receives the title line without the ':',
+     *              or an empty string if the block had none
+     * @return false once the stream has no more dungeons
+     */
+    bool next(Grid& out, std::string* title = nullptr);
+
+private:
+    bool fill();
+    bool nextLine(const char*& line, size_t& length);
+
+    std::istream& in;
+    std::vector<char> buffer;
+    size_t begin = 0;           // Unconsumed bytes are buffer[begin, end)
+    size_t end = 0;
+    bool eof = false;
+};
+
+/**
+ * Buffered writer producing the same text as printDungeon and
+ * printDungeonWithPath. Output is collected in a large buffer and handed
+ * to the stream in big writes, with no per-line flushes.
+ */
+class DungeonWriter {
+public:
+    /**
+     * @param out Stream to write; must outlive the writer
+     * @param bufferSize Bytes collected before each write to the stream
+     */
+    explicit DungeonWriter(std::ostream& out, size_t bufferSize = 1 << 20);
+    ~DungeonWriter();
+
+    DungeonWriter(const DungeonWriter&) = delete;
+    DungeonWriter& operator=(const DungeonWriter&) = delete;
+
+    /**
+     * Writes the optional "title:" line, every row, then a blank line.
+     */
+    void write(const GridView& dungeon, const std::string& title = "");
+    void write(const std::vector<std::string>& dungeon, const std::string& title = "");
+
+    /**
+     * Same as write(), with the path drawn as '*' over every cell except
+     * 'S' and 'E'. Path cells out of bounds are ignored. The dungeon is not
+     * copied: each row is appended to the output buffer and the path cells
+     * of that row are patched there.
+     */
+    void writeWithPath(const GridView& dungeon, const std::vector<Cell>& path, const std::string& title = "");
+    void writeWithPath(const std::vector<std::string>& dungeon, const std::vector<Cell>& path,
+                       const std::string& title = "");
+
+    // Hands everything buffered so far to the stream and flushes it
+    void flush();
+
+private:
+    void append(const char* data, size_t length);
+    void appendTitle(const std::string& title);
+    void appendRowWithPath(int r, const char* row, size_t length, const std::vector<Cell>& sorted, size_t& next);
+
+    std::ostream& out;
+    std::string buffer;
+    size_t bufferSize;
+};
@@ -1,7 +1,7 @@
 /**
  * Dungeon Pathfinder - Maze Generation
  *
- * This file implements recursive backtracking maze generation.
+ * This file implements backtracking maze generation (iterative, explicit stack).
  * The algorithm creates a "perfect maze" - exactly one path between any two points.
  */
 
@@ -9,14 +9,23 @@
 #include <random>
 #include <algorithm>
 #include <iostream>
+#include <cstdint>
 
 using namespace std;
 
 // Directions for maze carving: North, East, South, West (2-step moves)
 const int CARVE_DIRECTIONS[4][2] = {{-2, 0}, {0, 2}, {2, 0}, {0, -2}};
 
-// Random number generator (better than rand())
-static mt19937 rng(random_device{}());
+void Xoshiro256::seed(uint64_t value) {
+    // SplitMix64 turns one seed word into four well-mixed state words
+    for (uint64_t& word : state) {
+        value += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = value;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        word = z ^ (z >> 31);
+    }
+}
 
 /**
  * Helper function: Check if a coordinate is within bounds
@@ -25,14 +34,6 @@ bool isInBounds(int row, int col, int rows, int cols) {
     return row >= 0 && row < rows && col >= 0 && col < cols;
 }
 
-/**
- * Helper function: Check if a cell has been visited (carved)
- * In our representation, carved cells contain ' ' (space)
- */
-bool isCarved(const vector<string>& maze, int row, int col) {
-    return maze[row][col] == ' ';
-}
-
 /**
  * Helper function: Carve a passage between two cells
  * This removes the wall between start and end positions
@@ -48,72 +49,90 @@ void carvePassage(vector<string>& maze, int startRow, int startCol, int endRow,
 }
 
 /**
- * Helper function: Get all valid unvisited neighbors
- * Returns list of cells that can be carved to (2 steps away and not yet carved)
+ * Helper function: Shuffle the four carve directions in place and pack them
+ * into one byte (direction i of the order lives in bits 2i..2i+1)
  */
-vector<pair<int, int>> getUnvisitedNeighbors(const vector<string>& maze, int row, int col) {
-    vector<pair<int, int>> neighbors;
-    int rows = maze.size();
-    int cols = maze[0].size();
-
-    // Check all 4 directions (2 steps away)
-    for (int i = 0; i < 4; i++) {
-        int newRow = row + CARVE_DIRECTIONS[i][0];
-        int newCol = col + CARVE_DIRECTIONS[i][1];
-
-        if (isInBounds(newRow, newCol, rows, cols) && !isCarved(maze, newRow, newCol)) {
-            neighbors.push_back({newRow, newCol});
-        }
-    }
-
-    return neighbors;
+template <typename Engine>
+uint8_t shuffledDirections(Engine& rng) {
+    uint8_t dirs[4] = {0, 1, 2, 3};
+    shuffle(dirs, dirs + 4, rng);
+    return static_cast<uint8_t>(dirs[0] | (dirs[1] << 2) | (dirs[2] << 4) | (dirs[3] << 6));
 }
 
 /**
- * Helper function: Shuffle a vector randomly
- */
-template<typename T>
-void shuffleVector(vector<T>& vec) {
-    shuffle(vec.begin(), vec.end(), rng);
-}
-
-/**
- * TODO: Implement recursive backtracking maze carving
+ * Iterative backtracking maze carving
+ *
+ * Same algorithm as the classic recursive version (randomized depth-first
+ * search over odd coordinates), but the recursion is replaced by an explicit
+ * stack reserved up front for the worst case of one frame per maze cell.
+ * Frames are 8 bytes, so even grids with tens of millions of cells stay well
+ * within memory and nothing touches the call stack.
  *
  * ALGORITHM:
- * 1. Mark current cell as carved (set to ' ')
- * 2. Get all unvisited neighbors (2 steps away)
- * 3. Shuffle the neighbors for randomness
- * 4. For each neighbor:
- *    - If unvisited, carve passage to it and recurse
+ * 1. Carve the start cell and push it with a shuffled direction order
+ * 2. Look at the top frame and try its next direction (2 steps away)
+ * 3. If that neighbor is still a wall, carve the passage and push the neighbor
+ * 4. Once all four directions are tried, pop (this is the "backtrack")
  *
- * COORDINATE SYSTEM:
- * - Odd coordinates (1,1), (1,3), (3,1) etc. are potential room centers
- * - Even coordinates are walls between rooms
- * - We carve passages between odd coordinates
+ * If tree is given, every carved cell's parent (the cell it was carved from)
+ * and depth are recorded, which is the maze's spanning tree.
  *
- * HINTS:
- * - Use the helper functions provided above
- * - Base case: no unvisited neighbors (backtrack naturally)
- * - Remember to carve both the destination AND the wall between
+ * Carving stays inside rows [rowLo, rowHi) and columns [colLo, colHi), so
+ * disjoint regions can be carved independently (see generateDungeonGridTiled).
  */
-void recursiveBacktrack(vector<string>& maze, int row, int col) {
-    // Mark current cell as carved
-    maze[row][col] = ' ';
-
-    // YOUR CODE HERE:
-    // 1. Get unvisited neighbors using getUnvisitedNeighbors()
-    vector<pair<int, int>> unvisitedNeighbors = getUnvisitedNeighbors(maze, row, col);
-    // 2. Shuffle them using shuffleVector()
-    shuffleVector(unvisitedNeighbors);
-    // 3. For each neighbor, if it's still unvisited:
-    for (auto neighbor:unvisitedNeighbors)
-    {
-        if (!isCarved(maze, neighbor.first, neighbor.second))
-        {
-            carvePassage(maze, row, col, neighbor.first, neighbor.second);
-            recursiveBacktrack(maze, neighbor.first, neighbor.second);
+template <typename Engine>
+void carveMazeIterative(Grid& maze, int row, int col, BasicGeneratorContext<Engine>& ctx,
+                        MazeTree* tree, int rowLo, int colLo, int rowHi, int colHi) {
+    const int offsets[4] = {
+        CARVE_DIRECTIONS[0][0] * maze.stride + CARVE_DIRECTIONS[0][1],
+        CARVE_DIRECTIONS[1][0] * maze.stride + CARVE_DIRECTIONS[1][1],
+        CARVE_DIRECTIONS[2][0] * maze.stride + CARVE_DIRECTIONS[2][1],
+        CARVE_DIRECTIONS[3][0] * maze.stride + CARVE_DIRECTIONS[3][1],
+    };
+
+    vector<CarveFrame>& stack = ctx.carveStack;
+    stack.clear();
+    stack.reserve(static_cast<size_t>((rowHi - rowLo + 1) / 2) * ((colHi - colLo + 1) / 2));
+
+    maze.at(row, col) = ' ';
+    stack.push_back({maze.index(row, col), shuffledDirections(ctx.rng), 0});
+
+    if (tree) {
+        tree->parent.assign(maze.size(), -1);
+        tree->depth.assign(maze.size(), -1);
+        tree->root = maze.index(row, col);
+        tree->depth[tree->root] = 0;
+    }
+
+    while (!stack.empty()) {
+        CarveFrame& top = stack.back();
+        if (top.next == 4) {
+            stack.pop_back();
+            continue;
         }
+
+        int dir = (top.order >> (2 * top.next)) & 3;
+        top.next++;
+
+        Cell from = maze.cellAt(top.cell);
+        int newRow = from.r + CARVE_DIRECTIONS[dir][0];
+        int newCol = from.c + CARVE_DIRECTIONS[dir][1];
+        if (newRow < rowLo || newRow >= rowHi || newCol < colLo || newCol >= colHi) continue;
+
+        int target = top.cell + offsets[dir];
+        if (maze.cells[target] != '#') continue;  // Already carved
+
+        // Carve the destination and the wall in between, then descend
+        int wall = (top.cell + target) / 2;
+        maze.cells[target] = ' ';
+        maze.cells[wall] = ' ';
+        if (tree) {
+            tree->parent[wall] = top.cell;
+            tree->parent[target] = wall;
+            tree->depth[wall] = tree->depth[top.cell] + 1;
+            tree->depth[target] = tree->depth[top.cell] + 2;
+        }
+        stack.push_back({target, shuffledDirections(ctx.rng), 0});
     }
 }
 
@@ -121,57 +140,115 @@ void recursiveBacktrack(vector<string>& maze, int row, int col) {
  * Helper function: Add random rooms to the maze
  * Punches holes in walls to create larger open areas
  */
-void addRandomRooms(vector<string>& maze, int roomRate) {
-    int rows = maze.size();
-    int cols = maze[0].size();
+template <typename Engine>
+void addRandomRooms(Grid& maze, int roomRate, Engine& rng) {
+    int rows = maze.rows;
+    int cols = maze.cols;
 
     // Calculate how many rooms to add based on roomRate percentage
-    int totalWalls = (rows * cols) / 4;  // Rough estimate of wall cells
-    int roomsToAdd = (totalWalls * roomRate) / 100;
+    long long totalWalls = (static_cast<long long>(rows) * cols) / 4;  // Rough estimate of wall cells
+    long long roomsToAdd = (totalWalls * roomRate) / 100;
 
-    for (int i = 0; i < roomsToAdd; i++) {
-        int row = 2 + (rng() % (rows - 4));  // Avoid borders
-        int col = 2 + (rng() % (cols - 4));
+    for (long long i = 0; i < roomsToAdd; i++) {
+        int row = 2 + static_cast<int>(boundedRandom(rng, rows - 4));  // Avoid borders
+        int col = 2 + static_cast<int>(boundedRandom(rng, cols - 4));
 
         // Only carve if it's currently a wall
-        if (maze[row][col] == '#') {
-            maze[row][col] = ' ';
+        if (maze.at(row, col) == '#') {
+            maze.at(row, col) = ' ';
         }
     }
 }
 
 /**
  * Helper function: Place start and exit positions
- * Finds two open cells that are far apart and places S and E
+ * Start goes on the first open interior cell in row-major order and exit on
+ * the last one (likely far from start). Both are found by scanning from the
+ * two ends, so no list of open cells is built.
  */
-void placeStartAndExit(vector<string>& maze) {
-    vector<pair<int, int>> openCells;
-    int rows = maze.size();
-    int cols = maze[0].size();
-
-    // Find all open cells
-    for (int r = 1; r < rows - 1; r++) {
-        for (int c = 1; c < cols - 1; c++) {
-            if (maze[r][c] == ' ') {
-                openCells.push_back({r, c});
-            }
+void placeStartAndExit(Grid& maze) {
+    int first = -1, last = -1;
+
+    for (int r = 1; r < maze.rows - 1 && first == -1; r++) {
+        for (int c = 1; c < maze.cols - 1; c++) {
+            if (maze.at(r, c) == ' ') { first = maze.index(r, c); break; }
+        }
+    }
+    for (int r = maze.rows - 2; r >= 1 && last == -1; r--) {
+        for (int c = maze.cols - 2; c >= 1; c--) {
+            if (maze.at(r, c) == ' ') { last = maze.index(r, c); break; }
         }
     }
 
-    if (openCells.size() < 2) {
+    if (first == -1 || first == last) {
         cout << "Warning: Not enough open cells for start/exit placement!" << endl;
         return;
     }
 
-    // Place start at first open cell
-    maze[openCells[0].first][openCells[0].second] = 'S';
+    maze.cells[first] = 'S';
+    maze.cells[last] = 'E';
+    maze.start = maze.cellAt(first);
+    maze.exit = maze.cellAt(last);
+}
 
-    // Place exit at last open cell (likely far from start)
-    maze[openCells.back().first][openCells.back().second] = 'E';
+/**
+ * Helper function: BFS over cells equal to from, rewriting each one to to
+ * as it is reached (the grid itself is the visited set). Returns the cell
+ * dequeued last, which is one of the farthest from source.
+ */
+static int farthestBySweep(Grid& maze, int source, char from, char to, vector<int32_t>& queue) {
+    const int stride = maze.stride;
+    char* cells = maze.cells.data();
+    queue.clear();
+    queue.push_back(source);
+    cells[source] = to;
+
+    // Open cells never touch the outer border, so no bounds checks are needed
+    for (size_t head = 0; head < queue.size(); head++) {
+        const int current = queue[head];
+        const int neighbors[NUM_DIRECTIONS] = {current - stride, current + stride, current - 1, current + 1};
+        for (int next : neighbors) {
+            if (cells[next] != from) continue;
+            cells[next] = to;
+            queue.push_back(next);
+        }
+    }
+    return queue.back();
 }
 
+/**
+ * Helper function: Place start and exit at the two ends of a diameter
+ * Sweep 1 from the first open cell marks everything reachable as '.' and
+ * ends at the farthest cell u; sweep 2 from u turns the '.' back into ' '
+ * and ends at the cell v farthest from u. S goes on u, E on v. The only
+ * memory used is the reusable queue.
+ */
+void placeStartAndExitDiameter(Grid& maze, vector<int32_t>& queue) {
+    int first = -1;
+    for (int i = 0; i < maze.size() && first == -1; i++) {
+        if (maze.cells[i] == ' ') first = i;
+    }
+    if (first == -1) {
+        cout << "Warning: Not enough open cells for start/exit placement!" << endl;
+        return;
+    }
 
-std::vector<std::string> generateDungeon(int rows, int cols, int roomRate) {
+    int start = farthestBySweep(maze, first, ' ', '.', queue);
+    int exit = farthestBySweep(maze, start, '.', ' ', queue);
+    if (start == exit) {
+        cout << "Warning: Not enough open cells for start/exit placement!" << endl;
+        return;
+    }
+
+    maze.cells[start] = 'S';
+    maze.cells[exit] = 'E';
+    maze.start = maze.cellAt(start);
+    maze.exit = maze.cellAt(exit);
+}
+
+template <typename Engine>
+void generateDungeonInto(Grid& maze, int rows, int cols, int roomRate, BasicGeneratorContext<Engine>& ctx,
+                         MazeTree* tree) {
     // Ensure odd dimensions for proper maze structure
     if (rows % 2 == 0) rows++;
     if (cols % 2 == 0) cols++;
@@ -182,17 +259,224 @@ std::vector<std::string> generateDungeon(int rows, int cols, int roomRate) {
         cols = max(cols, 5);
     }
 
-    // Initialize maze with all walls
-    vector<string> maze(rows, string(cols, '#'));
+    // Initialize maze with all walls (assign keeps existing capacity)
+    maze.rows = rows;
+    maze.cols = cols;
+    maze.stride = cols;
+    maze.cells.assign(static_cast<size_t>(rows) * cols, '#');
+    maze.start = Cell(-1, -1);
+    maze.exit = Cell(-1, -1);
 
-    recursiveBacktrack(maze, 1,1);
     // Position (1,1) ensures we start at an odd coordinate (proper cell center)
+    carveMazeIterative(maze, 1, 1, ctx, tree, 0, 0, rows, cols);
 
-    // Add random rooms (provided)
-    addRandomRooms(maze, roomRate);
+    addRandomRooms(maze, roomRate, ctx.rng);
+    if (ctx.placement == StartExitPlacement::Diameter) placeStartAndExitDiameter(maze, ctx.sweepQueue);
+    else placeStartAndExit(maze);
+}
 
-    // Place start and exit (provided)
-    placeStartAndExit(maze);
+template <typename Engine>
+Grid generateDungeonGrid(int rows, int cols, int roomRate, BasicGeneratorContext<Engine>& ctx) {
+    Grid maze;
+    generateDungeonInto(maze, rows, cols, roomRate, ctx);
+    return maze;
+}
+
+template void generateDungeonInto(Grid&, int, int, int, BasicGeneratorContext<Xoshiro256>&, MazeTree*);
+template void generateDungeonInto(Grid&, int, int, int, BasicGeneratorContext<mt19937>&, MazeTree*);
+template void generateDungeonInto(Grid&, int, int, int, BasicGeneratorContext<mt19937_64>&, MazeTree*);
+template Grid generateDungeonGrid(int, int, int, BasicGeneratorContext<Xoshiro256>&);
+template Grid generateDungeonGrid(int, int, int, BasicGeneratorContext<mt19937>&);
+template Grid generateDungeonGrid(int, int, int, BasicGeneratorContext<mt19937_64>&);
+
+Grid generateDungeonGrid(int rows, int cols, int roomRate, uint64_t seed) {
+    GeneratorContext ctx(seed);
+    return generateDungeonGrid(rows, cols, roomRate, ctx);
+}
 
+Grid generateDungeonGrid(int rows, int cols, int roomRate, uint64_t seed, MazeTree& tree) {
+    GeneratorContext ctx(seed);
+    Grid maze;
+    generateDungeonInto(maze, rows, cols, roomRate, ctx, &tree);
     return maze;
 }
+
+Grid generateDungeonGrid(int rows, int cols, int roomRate) {
+    uint64_t seed = (static_cast<uint64_t>(random_device{}()) << 32) | random_device{}();
+    return generateDungeonGrid(rows, cols, roomRate, seed);
+}
+
+std::vector<std::string> generateDungeon(int rows, int cols, int roomRate) {
+    return generateDungeonGrid(rows, cols, roomRate).toStrings();
+}
+
+uint64_t batchDungeonSeed(uint64_t seed, size_t index) {
+    return mixHash64(seed + 0x9e3779b97f4a7c15ULL * (static_cast<uint64_t>(index) + 1));
+}
+
+void generateDungeons(vector<Grid>& out, int count, int rows, int cols, int roomRate,
+                      uint64_t seed, ThreadPool& pool, StartExitPlacement placement) {
+    out.resize(max(count, 0));
+
+    // One context per worker; reseeded per dungeon so results don't depend
+    // on which worker happened to build which dungeon
+    vector<GeneratorContext> contexts(pool.size(), GeneratorContext(seed, placement));
+
+    pool.parallelFor(out.size(), [&](size_t index, unsigned worker) {
+        GeneratorContext& ctx = contexts[worker];
+        ctx.reseed(batchDungeonSeed(seed, index));
+        generateDungeonInto(out[index], rows, cols, roomRate, ctx);
+    });
+}
+
+vector<Grid> generateDungeons(int count, int rows, int cols, int roomRate, uint64_t seed) {
+    vector<Grid> out;
+    generateDungeons(out, count, rows, cols, roomRate, seed);
+    return out;
+}
+
+Grid generateDungeonGridTiled(int rows, int cols, int roomRate, uint64_t seed, ThreadPool& pool,
+                              int tileCells) {
+    // Same size normalization as generateDungeonInto
+    if (rows % 2 == 0) rows++;
+    if (cols % 2 == 0) cols++;
+    rows = max(rows, 5);
+    cols = max(cols, 5);
+
+    Grid maze(rows, cols, '#');
+    const int cellRows = (rows - 1) / 2, cellCols = (cols - 1) / 2;
+    tileCells = max(tileCells, 1);
+    const int tileRows = (cellRows + tileCells - 1) / tileCells;
+    const int tileCols = (cellCols + tileCells - 1) / tileCells;
+
+    // Maze-cell range [first, last) of tile index i along one axis
+    auto firstCell = [&](int i) { return i * tileCells; };
+    auto lastCell = [&](int i, int cells) { return min(cells, (i + 1) * tileCells); };
+
+    // 1. Independent perfect maze per tile. Each tile writes only its own
+    //    cells and the walls between them, never a wall on a tile border.
+    vector<GeneratorContext> contexts(pool.size(), GeneratorContext(seed));
+    pool.parallelFor(static_cast<size_t>(tileRows) * tileCols, [&](size_t t, unsigned worker) {
+        GeneratorContext& ctx = contexts[worker];
+        ctx.reseed(batchDungeonSeed(seed, t));
+        const int tr = static_cast<int>(t) / tileCols, tc = static_cast<int>(t) % tileCols;
+        const int rowLo = 2 * firstCell(tr) + 1, rowHi = 2 * lastCell(tr, cellRows);
+        const int colLo = 2 * firstCell(tc) + 1, colHi = 2 * lastCell(tc, cellCols);
+        carveMazeIterative(maze, rowLo, colLo, ctx, nullptr, rowLo, colLo, rowHi, colHi);
+    });
+
+    // 2. Random spanning tree over the tiles (the same backtracking, one level
+    //    up), opening one border wall per tree edge. Trees joined by a tree of
+    //    single openings give one spanning tree, so the maze stays perfect.
+    GeneratorContext ctx(seed);
+    const int TILE_DIRECTIONS[4][2] = {{-1, 0}, {0, 1}, {1, 0}, {0, -1}};
+    vector<char> joined(static_cast<size_t>(tileRows) * tileCols, 0);
+    vector<CarveFrame>& stack = ctx.carveStack;
+    stack.clear();
+    joined[0] = 1;
+    stack.push_back({0, shuffledDirections(ctx.rng), 0});
+
+    while (!stack.empty()) {
+        CarveFrame& top = stack.back();
+        if (top.next == 4) {
+            stack.pop_back();
+            continue;
+        }
+
+        int dir = (top.order >> (2 * top.next)) & 3;
+        top.next++;
+        const int tr = top.cell / tileCols, tc = top.cell % tileCols;
+        const int nr = tr + TILE_DIRECTIONS[dir][0], nc = tc + TILE_DIRECTIONS[dir][1];
+        if (nr < 0 || nr >= tileRows || nc < 0 || nc >= tileCols) continue;
+        const int next = nr * tileCols + nc;
+        if (joined[next]) continue;
+
+        if (TILE_DIRECTIONS[dir][0] != 0) {
+            // Vertical neighbour: wall row between the two tiles, random column
+            int span = lastCell(tc, cellCols) - firstCell(tc);
+            int col = 2 * (firstCell(tc) + static_cast<int>(boundedRandom(ctx.rng, span))) + 1;
+            maze.at(2 * firstCell(max(tr, nr)), col) = ' ';
+        } else {
+            int span = lastCell(tr, cellRows) - firstCell(tr);
+            int row = 2 * (firstCell(tr) + static_cast<int>(boundedRandom(ctx.rng, span))) + 1;
+            maze.at(row, 2 * firstCell(max(tc, nc))) = ' ';
+        }
+
+        joined[next] = 1;
+        stack.push_back({next, shuffledDirections(ctx.rng), 0});
+    }
+
+    addRandomRooms(maze, roomRate, ctx.rng);
+    placeStartAndExit(maze);
+    return maze;
+}
+
+/**
+ * Helper function: BFS from start over open cells, treating doors whose
+ * letter bit is in openDoors as floor. parent receives the predecessor of
+ * each reached cell (start points to itself, -1 means unreached).
+ */
+static void reachFromStart(const Grid& grid, uint8_t openDoors, vector<int32_t>& parent,
+                           vector<int32_t>& queue) {
+    parent.assign(grid.size(), -1);
+    queue.clear();
+    const int start = grid.index(grid.start.r, grid.start.c);
+    parent[start] = start;
+    queue.push_back(start);
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        const Cell current = grid.cellAt(queue[head]);
+        for (int i = 0; i < NUM_DIRECTIONS; i++) {
+            const int r = current.r + DIRECTIONS[i][0], c = current.c + DIRECTIONS[i][1];
+            if (!grid.inBounds(r, c)) continue;
+            const int next = grid.index(r, c);
+            const uint8_t cls = cellClass(grid.cells[next]);
+            if (parent[next] != -1 || (cls & CELL_WALL)) continue;
+            if ((cls & CELL_DOOR) && !(openDoors & (1u << (cls & CELL_LETTER_MASK)))) continue;
+            parent[next] = queue[head];
+            queue.push_back(next);
+        }
+    }
+}
+
+int addKeysAndDoors(Grid& grid, int numKeys, uint64_t seed) {
+    static const char doors[] = "ABCDF";  // 'E' is the exit
+    numKeys = max(0, min(numKeys, 5));
+    if (numKeys == 0 || grid.start.r == -1 || grid.exit.r == -1) return 0;
+
+    vector<int32_t> parent, queue;
+    reachFromStart(grid, 0, parent, queue);
+    const int start = grid.index(grid.start.r, grid.start.c);
+    int cell = grid.index(grid.exit.r, grid.exit.c);
+    if (parent[cell] == -1) return 0;
+
+    vector<int32_t> path;
+    for (; cell != start; cell = parent[cell]) path.push_back(cell);
+    path.push_back(start);
+    reverse(path.begin(), path.end());
+    if (path.size() <= static_cast<size_t>(numKeys) + 1) return 0;
+
+    for (int i = 0; i < numKeys; i++) {
+        grid.cells[path[(i + 1) * path.size() / (numKeys + 1)]] = doors[i];
+    }
+
+    // Key i goes on a floor cell reachable with the doors before it open
+    Xoshiro256 rng(seed);
+    vector<int32_t> candidates;
+    uint8_t opened = 0;
+    int placed = 0;
+    for (int i = 0; i < numKeys; i++) {
+        reachFromStart(grid, opened, parent, queue);
+        opened |= static_cast<uint8_t>(1u << (cellClass(doors[i]) & CELL_LETTER_MASK));
+
+        candidates.clear();
+        for (int32_t reached : queue) {
+            if (grid.cells[reached] == ' ') candidates.push_back(reached);
+        }
+        if (candidates.empty()) continue;
+        const uint32_t pick = boundedRandom(rng, static_cast<uint32_t>(candidates.size()));
+        grid.cells[candidates[pick]] = static_cast<char>(doors[i] - 'A' + 'a');
+        placed++;
+    }
+    return placed;
+}
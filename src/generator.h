@@ -1,9 +1,131 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <random>
+#include "grid.h"
+#include "thread_pool.h"
+
+/**
+ * xoshiro256** pseudo-random generator (Blackman & Vigna). Much cheaper per
+ * number than mt19937 and with a 32-byte state, which makes it a good fit for
+ * bulk dungeon generation. Satisfies UniformRandomBitGenerator, so it works
+ * with std::shuffle and the <random> distributions.
+ */
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed = 0) { this->seed(seed); }
+
+    // Expands a 64-bit seed into the full state with SplitMix64
+    void seed(uint64_t value);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t state[4];
+};
+
+/**
+ * Unbiased random integer in [0, bound) for bound > 0, by Lemire's
+ * multiply-shift with rejection: one multiplication per draw, and a division
+ * only in the rare case the low product bits fall in the biased zone.
+ * Replaces rng() % bound, which divides every time and favours small values.
+ * Uses the top 32 bits of 64-bit engines.
+ */
+template <typename Engine>
+inline uint32_t boundedRandom(Engine& rng, uint32_t bound) {
+    auto draw = [&]() -> uint32_t {
+        if constexpr (Engine::max() > UINT32_MAX) return static_cast<uint32_t>(rng() >> 32);
+        else return static_cast<uint32_t>(rng());
+    };
+    uint64_t product = static_cast<uint64_t>(draw()) * bound;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < bound) {
+        const uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+        while (low < threshold) {
+            product = static_cast<uint64_t>(draw()) * bound;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return static_cast<uint32_t>(product >> 32);
+}
+
+/**
+ * Where generation puts 'S' and 'E'.
+ *   Scan     - first and last open interior cell in row-major order
+ *   Diameter - the two ends of a longest shortest path, found with two BFS
+ *              sweeps (exact for perfect mazes, a close lower bound once rooms
+ *              add loops), which makes the map as long to solve as possible;
+ *              costs about two BFS runs per dungeon on top of generation
+ */
+enum class StartExitPlacement {
+    Scan,
+    Diameter
+};
+
+/**
+ * Stack frame for iterative maze carving: the cell being expanded (flat grid
+ * index), its shuffled direction order packed two bits per direction, and how
+ * many of those directions have been tried so far.
+ */
+struct CarveFrame {
+    int32_t cell;
+    uint8_t order;
+    uint8_t next;
+};
+
+/**
+ * Per-caller generator state: the seed, its own RNG engine, the start/exit
+ * placement mode and the carving stack and BFS sweep queue (kept between
+ * calls so repeated generation reuses their capacity).
+ * Nothing is shared between contexts, so one context per thread makes
+ * generation reentrant, and the same seed always yields the same dungeon.
+ *
+ * Engine can be any UniformRandomBitGenerator constructible from a uint64_t
+ * seed; the explicitly supported ones are Xoshiro256 (default), std::mt19937
+ * and std::mt19937_64.
+ */
+template <typename Engine = Xoshiro256>
+struct BasicGeneratorContext {
+    uint64_t seed;
+    Engine rng;
+    std::vector<CarveFrame> carveStack;
+    std::vector<int32_t> sweepQueue;    // Diameter placement only
+    StartExitPlacement placement = StartExitPlacement::Scan;
+
+    explicit BasicGeneratorContext(uint64_t seed, StartExitPlacement placement = StartExitPlacement::Scan)
+        : seed(seed), rng(static_cast<typename Engine::result_type>(seed)), placement(placement) {}
+
+    // Restarts the random stream from a new seed
+    void reseed(uint64_t value) {
+        seed = value;
+        rng.seed(static_cast<typename Engine::result_type>(value));
+    }
+};
+
+using GeneratorContext = BasicGeneratorContext<Xoshiro256>;
 
 /**
  * Generates a random dungeon using recursive backtracking algorithm.
+ * Each call draws a fresh seed from std::random_device; use the overloads
+ * taking a seed or a GeneratorContext for reproducible output.
  * Creates a perfect maze (exactly one path between any two points) and
  * optionally adds extra rooms for gameplay variety.
  * 
@@ -15,6 +137,116 @@
  */
 std::vector<std::string> generateDungeon(int rows, int cols, int roomRate = 20);
 
+/**
+ * Same as generateDungeon, but returns the flat Grid directly (no per-row
+ * strings) with start and exit already recorded. Carving is iterative with an
+ * explicit stack, so very large dungeons (e.g. 4001x4001) are safe.
+ *
+ * @param rows Number of rows in the dungeon (rounded up to odd)
+ * @param cols Number of columns in the dungeon (rounded up to odd)
+ * @param roomRate Percentage (0-100) of additional rooms to punch after maze generation
+ * @return Flat dungeon grid using the same characters as generateDungeon
+ */
+Grid generateDungeonGrid(int rows, int cols, int roomRate = 20);
+
+/**
+ * Reproducible variant: the same (rows, cols, roomRate, seed) always
+ * produces the same dungeon.
+ */
+Grid generateDungeonGrid(int rows, int cols, int roomRate, uint64_t seed);
+
+/**
+ * Generates into the caller's context, drawing randomness from ctx.rng and
+ * reusing ctx.carveStack. Safe to call concurrently with distinct contexts.
+ */
+template <typename Engine>
+Grid generateDungeonGrid(int rows, int cols, int roomRate, BasicGeneratorContext<Engine>& ctx);
+
+extern template Grid generateDungeonGrid(int, int, int, BasicGeneratorContext<Xoshiro256>&);
+extern template Grid generateDungeonGrid(int, int, int, BasicGeneratorContext<std::mt19937>&);
+extern template Grid generateDungeonGrid(int, int, int, BasicGeneratorContext<std::mt19937_64>&);
+
+/**
+ * Reproducible generation that also returns the maze's spanning tree: the
+ * parent pointers implied by the carving order. With roomRate = 0 the maze
+ * is perfect and the tree is the whole dungeon, so treePath() can solve it
+ * without searching.
+ */
+Grid generateDungeonGrid(int rows, int cols, int roomRate, uint64_t seed, MazeTree& tree);
+
+/**
+ * Like generateDungeonGrid, but writes into an existing Grid, reusing its
+ * buffer when it is already large enough. Used by the batch API so repeated
+ * runs over the same storage don't reallocate. If tree is non-null the
+ * carving spanning tree is written to it.
+ */
+template <typename Engine>
+void generateDungeonInto(Grid& out, int rows, int cols, int roomRate, BasicGeneratorContext<Engine>& ctx,
+                         MazeTree* tree = nullptr);
+
+extern template void generateDungeonInto(Grid&, int, int, int, BasicGeneratorContext<Xoshiro256>&, MazeTree*);
+extern template void generateDungeonInto(Grid&, int, int, int, BasicGeneratorContext<std::mt19937>&, MazeTree*);
+extern template void generateDungeonInto(Grid&, int, int, int, BasicGeneratorContext<std::mt19937_64>&, MazeTree*);
+
+/**
+ * Seed used for dungeon number index of a batch started from seed.
+ * generateDungeonGrid(rows, cols, roomRate, batchDungeonSeed(seed, i))
+ * reproduces element i of generateDungeons(count, rows, cols, roomRate, seed).
+ */
+uint64_t batchDungeonSeed(uint64_t seed, size_t index);
+
+/**
+ * Generates count dungeons in parallel on a thread pool. Every dungeon gets its
+ * own RNG stream derived from (seed, index), and each worker keeps one
+ * GeneratorContext for all the dungeons it builds, so the output is identical
+ * regardless of the number of threads.
+ *
+ * @param out Destination; resized to count, existing Grid buffers are reused
+ * @param count Number of dungeons to generate
+ * @param rows Rows per dungeon
+ * @param cols Columns per dungeon
+ * @param roomRate Percentage (0-100) of additional rooms
+ * @param seed Base seed for the whole batch
+ * @param pool Pool to run on (defaults to the shared hardware-sized pool)
+ * @param placement Where S and E go in every dungeon
+ */
+void generateDungeons(std::vector<Grid>& out, int count, int rows, int cols, int roomRate,
+                      uint64_t seed, ThreadPool& pool = ThreadPool::shared(),
+                      StartExitPlacement placement = StartExitPlacement::Scan);
+
+/**
+ * Convenience overload returning a freshly allocated batch.
+ */
+std::vector<Grid> generateDungeons(int count, int rows, int cols, int roomRate, uint64_t seed);
+
+/**
+ * Large-map generation that scales with cores. The maze cells are split
+ * into tileCells x tileCells tiles, each tile is carved as its own perfect
+ * maze in parallel (RNG stream derived from (seed, tile index)), and the
+ * tiles are then joined by a random spanning tree of single border
+ * openings. The result is still a perfect maze before rooms are added, and
+ * is identical for any number of threads.
+ *
+ * The layout differs from generateDungeonGrid with the same seed, and the
+ * tile seams are visible as long straight walls broken by one opening.
+ *
+ * @param tileCells Tile edge in maze cells (grid cells / 2)
+ */
+Grid generateDungeonGridTiled(int rows, int cols, int roomRate, uint64_t seed,
+                              ThreadPool& pool = ThreadPool::shared(), int tileCells = 256);
+
+/**
+ * Turns a solvable dungeon into a key-door map for tests and benchmarks.
+ * Up to numKeys (at most 5) doors, lettered A, B, C, D, F since 'E' is the
+ * exit, are spread along the S-E shortest path, and each key goes on a
+ * random floor cell reachable from S once the doors before it are open, so
+ * the map stays solvable. The same seed always places the same keys.
+ *
+ * @return Number of key-door pairs placed; 0 if the grid has no S-E path
+ *         long enough to hold the doors (the grid is then left unchanged)
+ */
+int addKeysAndDoors(Grid& grid, int numKeys, uint64_t seed);
+
 /**
  * Helper function to check if a cell coordinate is valid within the dungeon bounds
  * and represents a carveable cell (odd coordinates in a perfect maze).
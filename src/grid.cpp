@@ -0,0 +1,66 @@
+/**
+ * Dungeon Pathfinder - Flat Grid
+ *
+ * Conversion between the vector<string> dungeon format and the contiguous Grid.
+ */
+
+#include "grid.h"
+#include <algorithm>
+
+using namespace std;
+
+Grid::Grid(int rows, int cols, char fill)
+    : rows(rows), cols(cols), stride(cols), cells(static_cast<size_t>(rows) * cols, fill) {}
+
+Grid::Grid(const vector<string>& dungeon) {
+    assign(dungeon);
+}
+
+void Grid::assign(const vector<string>& dungeon) {
+    rows = static_cast<int>(dungeon.size());
+    cols = rows > 0 ? static_cast<int>(dungeon[0].size()) : 0;
+    stride = cols;
+    cells.assign(static_cast<size_t>(rows) * cols, '#');
+
+    for (int r = 0; r < rows; r++) {
+        int width = min(cols, static_cast<int>(dungeon[r].size()));
+        if (width <= 0) continue;
+        dungeon[r].copy(cells.data() + static_cast<size_t>(r) * stride, width);
+    }
+
+    locateEndpoints();
+}
+
+/**
+ * Helper function: Row-major scan for 'S' and 'E', first occurrence wins
+ * (same as findPosition)
+ */
+static void locateEndpointsIn(const char* cells, int rows, int cols, int stride, Cell& start, Cell& exit) {
+    start = Cell(-1, -1);
+    exit = Cell(-1, -1);
+    for (int r = 0; r < rows; r++) {
+        const char* row = cells + static_cast<size_t>(r) * stride;
+        for (int c = 0; c < cols; c++) {
+            if (row[c] == 'S' && start.r == -1) start = Cell(r, c);
+            else if (row[c] == 'E' && exit.r == -1) exit = Cell(r, c);
+        }
+    }
+}
+
+void Grid::locateEndpoints() {
+    locateEndpointsIn(cells.data(), rows, cols, stride, start, exit);
+}
+
+GridView::GridView(const char* cells, int rows, int cols, int stride)
+    : cells(cells), rows(rows), cols(cols), stride(stride) {
+    locateEndpointsIn(cells, rows, cols, stride, start, exit);
+}
+
+vector<string> Grid::toStrings() const {
+    vector<string> dungeon;
+    dungeon.reserve(rows);
+    for (int r = 0; r < rows; r++) {
+        dungeon.emplace_back(cells.data() + static_cast<size_t>(r) * stride, cols);
+    }
+    return dungeon;
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <vector>
+#include <string>
+#include "cell.h"
+
+/**
+ * Flat dungeon representation: one contiguous byte buffer in row-major order.
+ * Cell (r, c) lives at cells[r * stride + c]. Start 'S' and exit 'E' are located
+ * once at construction so solvers don't have to rescan the map for every query.
+ *
+ * Use this instead of vector<string> for large dungeons: every row shares the
+ * same allocation, and solvers can index flat visited/parent arrays with index().
+ */
+struct Grid {
+    int rows = 0;
+    int cols = 0;
+    int stride = 0;             // Distance in bytes between the starts of two rows
+    std::vector<char> cells;    // rows * stride characters
+    Cell start = Cell(-1, -1);  // Position of 'S', or (-1, -1) if missing
+    Cell exit = Cell(-1, -1);   // Position of 'E', or (-1, -1) if missing
+
+    Grid() = default;
+
+    /**
+     * Creates a rows x cols grid with every cell set to fill.
+     */
+    Grid(int rows, int cols, char fill = '#');
+
+    /**
+     * Copies a vector<string> dungeon into flat storage. Rows shorter than the
+     * first one are padded with walls so every row has the same width.
+     */
+    explicit Grid(const std::vector<std::string>& dungeon);
+
+    /**
+     * Same conversion as the constructor above, reusing this grid's storage.
+     */
+    void assign(const std::vector<std::string>& dungeon);
+
+    // Flat index of (row, col); also used to index per-cell solver arrays
+    int index(int row, int col) const { return row * stride + col; }
+
+    // Converts a flat index back into a Cell
+    Cell cellAt(int idx) const { return Cell(idx / stride, idx % stride); }
+
+    char at(int row, int col) const { return cells[index(row, col)]; }
+    char& at(int row, int col) { return cells[index(row, col)]; }
+
+    bool inBounds(int row, int col) const {
+        return row >= 0 && row < rows && col >= 0 && col < cols;
+    }
+
+    // Total number of addressable slots (size of a per-cell solver array)
+    int size() const { return rows * stride; }
+
+    /**
+     * Rescans the buffer for 'S' and 'E' and updates start/exit.
+     * Call this after editing the grid in place.
+     */
+    void locateEndpoints();
+
+    /**
+     * Converts back to the vector<string> representation used by printDungeon.
+     */
+    std::vector<std::string> toStrings() const;
+};
+
+/**
+ * Non-owning read-only view of a flat dungeon: the same layout as Grid, but
+ * cells points into storage owned by someone else (a Grid, a memory-mapped
+ * file, a caller's buffer). Solvers, validation and printing take a view, so
+ * a Grid converts implicitly and nothing is copied. The viewed storage must
+ * outlive the view.
+ */
+struct GridView {
+    const char* cells = nullptr;  // rows * stride characters
+    int rows = 0;
+    int cols = 0;
+    int stride = 0;
+    Cell start = Cell(-1, -1);
+    Cell exit = Cell(-1, -1);
+
+    GridView() = default;
+
+    // View of a whole Grid, with its precomputed start and exit
+    GridView(const Grid& grid)
+        : cells(grid.cells.data()), rows(grid.rows), cols(grid.cols), stride(grid.stride),
+          start(grid.start), exit(grid.exit) {}
+
+    /**
+     * View of an external row-major buffer; scans it once for 'S' and 'E'.
+     */
+    GridView(const char* cells, int rows, int cols, int stride);
+
+    int index(int row, int col) const { return row * stride + col; }
+    Cell cellAt(int idx) const { return Cell(idx / stride, idx % stride); }
+    char at(int row, int col) const { return cells[index(row, col)]; }
+    const char* row(int r) const { return cells + static_cast<size_t>(r) * stride; }
+
+    bool inBounds(int row, int col) const {
+        return row >= 0 && row < rows && col >= 0 && col < cols;
+    }
+
+    int size() const { return rows * stride; }
+};
+
+/**
+ * Spanning tree of a carved maze, recorded by the generator while carving.
+ * parent[i] is the cell that cell i was carved from (-1 for the root and for
+ * cells that are not part of the tree, such as walls and punched rooms), and
+ * depth[i] is the number of steps from the root (-1 outside the tree).
+ * Both arrays are indexed like Grid::cells.
+ */
+struct MazeTree {
+    std::vector<int> parent;
+    std::vector<int> depth;
+    int root = -1;
+};
@@ -0,0 +1,295 @@
+/**
+ * Dungeon Pathfinder - Hierarchical Solver
+ *
+ * HPA*: abstract entrance graph over the tiles of a ChunkedGrid, A* on that
+ * graph, then tile-local BFS refinement along the abstract route.
+ */
+
+#include "hierarchical_solver.h"
+#include <algorithm>
+#include <queue>
+#include <cstdlib>
+
+using namespace std;
+
+// Border runs at least this long get an entrance at each end instead of one in the middle
+static const int WIDE_ENTRANCE = 6;
+
+HierarchicalSolver::HierarchicalSolver(const ChunkedGrid& grid, ThreadPool& pool)
+    : grid(grid), tileNodes(grid.tileCount()) {
+    const int size = grid.tileSize;
+
+    // Walks length cells along one tile border; a runs along the first tile's
+    // edge and b is its neighbour across the border
+    auto scanBorder = [&](Cell a, Cell b, int dr, int dc, int length) {
+        int run = 0;
+        for (int i = 0; i <= length; i++) {
+            bool crossing = i < length && isOpenChar(grid.at(a.r + i * dr, a.c + i * dc)) &&
+                            isOpenChar(grid.at(b.r + i * dr, b.c + i * dc));
+            if (crossing) {
+                run++;
+                continue;
+            }
+            if (run == 0) continue;
+
+            int first = i - run, last = i - 1;
+            if (run < WIDE_ENTRANCE) {
+                int mid = first + run / 2;
+                addEntrance(Cell(a.r + mid * dr, a.c + mid * dc), Cell(b.r + mid * dr, b.c + mid * dc));
+            } else {
+                addEntrance(Cell(a.r + first * dr, a.c + first * dc), Cell(b.r + first * dr, b.c + first * dc));
+                addEntrance(Cell(a.r + last * dr, a.c + last * dc), Cell(b.r + last * dr, b.c + last * dc));
+            }
+            run = 0;
+        }
+    };
+
+    for (int tr = 0; tr < grid.tileRows; tr++) {
+        for (int tc = 0; tc < grid.tileCols; tc++) {
+            const int r0 = tr * size, c0 = tc * size;
+            const int height = min(size, grid.rows - r0), width = min(size, grid.cols - c0);
+            if (tr + 1 < grid.tileRows) {
+                scanBorder(Cell(r0 + size - 1, c0), Cell(r0 + size, c0), 0, 1, width);
+            }
+            if (tc + 1 < grid.tileCols) {
+                scanBorder(Cell(r0, c0 + size - 1), Cell(r0, c0 + size), 1, 0, height);
+            }
+        }
+    }
+
+    // Intra-tile edges: one tile-local BFS per entrance. A task only appends
+    // to the edge lists of its own tile's nodes, so tiles run in parallel.
+    vector<TileSearch> searches(pool.size());
+    pool.parallelFor(grid.tileCount(), [&](size_t t, unsigned worker) {
+        TileSearch& local = searches[worker];
+        const vector<int>& inside = tileNodes[t];
+        const Cell origin = grid.tileOrigin(static_cast<int>(t));
+        for (int u : inside) {
+            searchTile(static_cast<int>(t), nodes[u].cell, local);
+            for (int v : inside) {
+                if (v == u) continue;
+                int d = local.dist[(nodes[v].cell.r - origin.r) * size + nodes[v].cell.c - origin.c];
+                if (d > 0) edges[u].push_back(Edge{v, d});
+            }
+        }
+    });
+}
+
+/**
+ * Helper function: Abstract node at cell, created on first use. Corner cells
+ * can be entrances of two borders, so look in the tile's node list first.
+ */
+int HierarchicalSolver::addNode(Cell cell) {
+    const int tile = grid.tileOf(cell.r, cell.c);
+    for (int id : tileNodes[tile]) {
+        if (nodes[id].cell == cell) return id;
+    }
+    nodes.push_back(Node{cell, tile});
+    edges.emplace_back();
+    tileNodes[tile].push_back(static_cast<int>(nodes.size()) - 1);
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+/**
+ * Helper function: Entrance pair across a tile border, linked both ways with cost 1
+ */
+void HierarchicalSolver::addEntrance(Cell a, Cell b) {
+    int u = addNode(a), v = addNode(b);
+    edges[u].push_back(Edge{v, 1});
+    edges[v].push_back(Edge{u, 1});
+}
+
+size_t HierarchicalSolver::edgeCount() const {
+    size_t total = 0;
+    for (const vector<Edge>& list : edges) total += list.size();
+    return total;
+}
+
+/**
+ * Helper function: BFS from source over tile's cells only. Leaves dist (-1 if
+ * unreached) and parent (-1 at the source) in tile-local indices.
+ */
+void HierarchicalSolver::searchTile(int tile, Cell source, TileSearch& search) const {
+    const int size = grid.tileSize;
+    const int area = size * size;
+    const char* cells = grid.tile(tile);
+    const Cell origin = grid.tileOrigin(tile);
+
+    search.dist.assign(area, -1);
+    search.parent.resize(area);
+    search.queue.resize(area);
+
+    const int from = (source.r - origin.r) * size + source.c - origin.c;
+    if (!isOpenChar(cells[from])) return;
+
+    int head = 0, tail = 0;
+    search.queue[tail++] = from;
+    search.dist[from] = 0;
+    search.parent[from] = -1;
+
+    // Padding walls stop the search at the map edge; tile edges need explicit checks
+    while (head < tail) {
+        const int current = search.queue[head++];
+        const int col = current % size;
+        int neighbors[NUM_DIRECTIONS];
+        int count = 0;
+        if (current >= size) neighbors[count++] = current - size;
+        if (current + size < area) neighbors[count++] = current + size;
+        if (col > 0) neighbors[count++] = current - 1;
+        if (col + 1 < size) neighbors[count++] = current + 1;
+
+        for (int i = 0; i < count; i++) {
+            const int next = neighbors[i];
+            if (search.dist[next] != -1 || !isOpenChar(cells[next])) continue;
+            search.dist[next] = search.dist[current] + 1;
+            search.parent[next] = current;
+            search.queue[tail++] = next;
+        }
+    }
+}
+
+/**
+ * Helper function: Appends the tile-local shortest path from from (already
+ * at the back of out) to to. Returns false if to is not reachable in the tile.
+ */
+bool HierarchicalSolver::refineTile(int tile, Cell from, Cell to, vector<Cell>& out) {
+    searchTile(tile, from, search);
+    const int size = grid.tileSize;
+    const Cell origin = grid.tileOrigin(tile);
+    int idx = (to.r - origin.r) * size + to.c - origin.c;
+    if (search.dist[idx] < 0) return false;
+
+    const size_t begin = out.size();
+    for (; search.parent[idx] != -1; idx = search.parent[idx]) {
+        out.push_back(Cell(origin.r + idx / size, origin.c + idx % size));
+    }
+    reverse(out.begin() + begin, out.end());
+    touchTile(tile);
+    return true;
+}
+
+/**
+ * Helper function: Count tile towards tilesTouched() once per query
+ */
+void HierarchicalSolver::touchTile(int tile) {
+    if (tileSeen[tile] == stamp) return;
+    tileSeen[tile] = stamp;
+    touched++;
+}
+
+std::vector<Cell> HierarchicalSolver::path() {
+    return path(grid.start, grid.exit);
+}
+
+std::vector<Cell> HierarchicalSolver::path(Cell from, Cell to) {
+    touched = 0;
+    if (!grid.inBounds(from.r, from.c) || !grid.inBounds(to.r, to.c) ||
+        !isOpenChar(grid.at(from.r, from.c)) || !isOpenChar(grid.at(to.r, to.c))) {
+        return vector<Cell>();
+    }
+    if (from == to) return vector<Cell>(1, from);
+
+    // Abstract ids: real nodes, then the two query endpoints
+    const int total = static_cast<int>(nodes.size()) + 2;
+    const int START = total - 2, GOAL = total - 1;
+    if (cost.size() < static_cast<size_t>(total)) {
+        cost.resize(total);
+        parent.resize(total);
+        seen.resize(total, 0);
+    }
+    if (tileSeen.size() < static_cast<size_t>(grid.tileCount())) tileSeen.resize(grid.tileCount(), 0);
+    stamp++;
+
+    const int fromTile = grid.tileOf(from.r, from.c);
+    const int toTile = grid.tileOf(to.r, to.c);
+    const int size = grid.tileSize;
+
+    // Local distances from the endpoints to their tiles' entrances
+    auto localIndex = [&](int tile, Cell cell) {
+        Cell origin = grid.tileOrigin(tile);
+        return (cell.r - origin.r) * size + cell.c - origin.c;
+    };
+    vector<Edge> startEdges, goalEdges;
+    int direct = -1;
+    touchTile(fromTile);
+    touchTile(toTile);
+    searchTile(fromTile, from, search);
+    for (int v : tileNodes[fromTile]) {
+        int d = search.dist[localIndex(fromTile, nodes[v].cell)];
+        if (d >= 0) startEdges.push_back(Edge{v, d});
+    }
+    if (fromTile == toTile) direct = search.dist[localIndex(toTile, to)];
+    searchTile(toTile, to, search);
+    for (int v : tileNodes[toTile]) {
+        int d = search.dist[localIndex(toTile, nodes[v].cell)];
+        if (d >= 0) goalEdges.push_back(Edge{v, d});
+    }
+
+    auto heuristic = [&](int node) {
+        if (node == GOAL) return 0;
+        const Cell& cell = node == START ? from : nodes[node].cell;
+        return abs(cell.r - to.r) + abs(cell.c - to.c);
+    };
+
+    // A* over the abstract graph, stale queue entries skipped by cost
+    using Entry = pair<int, int>;  // (f, node)
+    priority_queue<Entry, vector<Entry>, greater<Entry>> open;
+    auto relax = [&](int u, int v, int step) {
+        int g = cost[u] + step;
+        if (seen[v] == stamp && cost[v] <= g) return;
+        seen[v] = stamp;
+        cost[v] = g;
+        parent[v] = u;
+        open.push({g + heuristic(v), v});
+    };
+
+    seen[START] = stamp;
+    cost[START] = 0;
+    parent[START] = -1;
+    open.push({heuristic(START), START});
+    bool found = false;
+
+    while (!open.empty()) {
+        auto [f, node] = open.top();
+        open.pop();
+        if (f != cost[node] + heuristic(node)) continue;
+        if (node == GOAL) {
+            found = true;
+            break;
+        }
+
+        if (node == START) {
+            for (const Edge& edge : startEdges) relax(START, edge.to, edge.cost);
+            if (direct >= 0) relax(START, GOAL, direct);
+            continue;
+        }
+        for (const Edge& edge : edges[node]) relax(node, edge.to, edge.cost);
+        if (nodes[node].tile == toTile) {
+            for (const Edge& edge : goalEdges) {
+                if (edge.to == node) relax(node, GOAL, edge.cost);
+            }
+        }
+    }
+    if (!found) return vector<Cell>();
+
+    // Abstract route as cells, then refine each hop that stays inside a tile
+    vector<Cell> waypoints;
+    for (int node = GOAL; node != -1; node = parent[node]) {
+        waypoints.push_back(node == GOAL ? to : node == START ? from : nodes[node].cell);
+    }
+    reverse(waypoints.begin(), waypoints.end());
+
+    vector<Cell> result;
+    result.push_back(from);
+    for (size_t i = 1; i < waypoints.size(); i++) {
+        const Cell& a = waypoints[i - 1];
+        const Cell& b = waypoints[i];
+        int tile = grid.tileOf(a.r, a.c);
+        if (tile != grid.tileOf(b.r, b.c)) {
+            result.push_back(b);  // Entrance hop across a border
+        } else if (!refineTile(tile, a, b, result)) {
+            return vector<Cell>();
+        }
+    }
+    return result;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "cell.h"
+#include "chunked_grid.h"
+#include "thread_pool.h"
+
+/**
+ * HPA* (hierarchical path-finding A*) over a ChunkedGrid, basic-BFS rules
+ * (walls and doors block).
+ *
+ * Construction finds the entrances on every tile border: each maximal run of
+ * cells open on both sides gets one entrance pair in its middle, or two at its
+ * ends when the run is 6 cells or longer. Entrances become abstract nodes,
+ * linked across the border with cost 1 and, inside each tile, to every other
+ * entrance of that tile with the tile-local BFS distance. Tiles are processed
+ * in parallel on pool.
+ *
+ * A query connects the endpoints to their tiles' entrances, runs A* over the
+ * abstract graph, and then refines only the tiles on the abstract route with
+ * tile-local BFS. Long queries read a small fraction of the tiles. Paths are
+ * valid but not always shortest: inside a tile the route goes through the
+ * entrances, which is typically within a few percent of optimal.
+ */
+class HierarchicalSolver {
+public:
+    /**
+     * Builds the abstract graph. The grid must outlive the solver.
+     */
+    explicit HierarchicalSolver(const ChunkedGrid& grid, ThreadPool& pool = ThreadPool::shared());
+
+    /**
+     * Path from from to to (inclusive), or empty if unreachable.
+     */
+    std::vector<Cell> path(Cell from, Cell to);
+
+    // Path from grid.start to grid.exit
+    std::vector<Cell> path();
+
+    size_t nodeCount() const { return nodes.size(); }
+    size_t edgeCount() const;
+
+    // Distinct tiles whose cells the last path() call searched
+    size_t tilesTouched() const { return touched; }
+
+    /**
+     * Scratch for one tile-local BFS; dist and parent use tile-local indices.
+     */
+    struct TileSearch {
+        std::vector<int> dist;
+        std::vector<int> parent;
+        std::vector<int> queue;
+    };
+
+private:
+    struct Node {
+        Cell cell;
+        int tile;
+    };
+    struct Edge {
+        int to;
+        int cost;
+    };
+
+    int addNode(Cell cell);
+    void addEntrance(Cell a, Cell b);
+    void searchTile(int tile, Cell source, TileSearch& search) const;
+    bool refineTile(int tile, Cell from, Cell to, std::vector<Cell>& out);
+    void touchTile(int tile);
+
+    const ChunkedGrid& grid;
+    std::vector<Node> nodes;
+    std::vector<std::vector<Edge>> edges;
+    std::vector<std::vector<int>> tileNodes;   // Abstract nodes inside each tile
+
+    // Query scratch, reused between calls
+    TileSearch search;
+    std::vector<int> cost;
+    std::vector<int> parent;
+    std::vector<uint32_t> seen;
+    std::vector<uint32_t> tileSeen;
+    uint32_t stamp = 0;
+    size_t touched = 0;
+};
@@ -0,0 +1,214 @@
+/**
+ * Dungeon Pathfinder - Incremental Solver
+ *
+ * D* Lite over the flat grid: keeps the S-E path of an edited dungeon
+ * up to date by repairing only the distances an edit affects.
+ */
+
+#include "incremental_solver.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+using namespace std;
+
+static const int INF = INT_MAX / 4;  // Leaves room for adding h and km without overflow
+
+/**
+ * Helper function: Flat indices of the in-bounds 4-neighbours of idx.
+ * Returns how many were written.
+ */
+static int neighborsOf(const Grid& grid, int idx, int (&out)[NUM_DIRECTIONS]) {
+    const int stride = grid.stride;
+    const int col = idx % stride;
+    int count = 0;
+    if (idx >= stride) out[count++] = idx - stride;
+    if (idx + stride < grid.size()) out[count++] = idx + stride;
+    if (col > 0) out[count++] = idx - 1;
+    if (col + 1 < grid.cols) out[count++] = idx + 1;
+    return count;
+}
+
+IncrementalSolver::IncrementalSolver(const Grid& grid) : grid(grid) {
+    reset();
+}
+
+void IncrementalSolver::reset() {
+    const int size = grid.size();
+    g.assign(size, INF);
+    rhs.assign(size, INF);
+    open.resize(size);
+    for (int i = 0; i < size; i++) open[i] = isOpenChar(grid.cells[i]);
+    queue = decltype(queue)();
+
+    startIdx = grid.start.r == -1 ? -1 : grid.index(grid.start.r, grid.start.c);
+    exitIdx = grid.exit.r == -1 ? -1 : grid.index(grid.exit.r, grid.exit.c);
+    lastStart = startIdx;
+    km = 0;
+    expandedCells = 0;
+
+    if (exitIdx != -1 && open[exitIdx]) {
+        rhs[exitIdx] = 0;
+        updateVertex(exitIdx);
+    }
+}
+
+/**
+ * Helper function: Manhattan distance between two flat indices (0 if either
+ * is missing, which only makes queued keys smaller and is still admissible)
+ */
+int IncrementalSolver::heuristic(int a, int b) const {
+    if (a < 0 || b < 0) return 0;
+    const int stride = grid.stride;
+    return abs(a / stride - b / stride) + abs(a % stride - b % stride);
+}
+
+IncrementalSolver::Key IncrementalSolver::calculateKey(int cell) const {
+    int best = min(g[cell], rhs[cell]);
+    return Key(best + heuristic(startIdx, cell) + km, best, cell);
+}
+
+/**
+ * Helper function: rhs of a non-exit cell, 1 + the smallest g among its
+ * open neighbours (INF for blocked cells or dead ends)
+ */
+int IncrementalSolver::bestSuccessor(int cell) const {
+    if (!open[cell]) return INF;
+    int next[NUM_DIRECTIONS];
+    int count = neighborsOf(grid, cell, next);
+    int best = INF;
+    for (int i = 0; i < count; i++) {
+        if (open[next[i]] && g[next[i]] + 1 < best) best = g[next[i]] + 1;
+    }
+    return best;
+}
+
+/**
+ * Helper function: Queue cell if it is inconsistent. Consistent cells are
+ * not removed; their stale entries are skipped when they reach the top.
+ */
+void IncrementalSolver::updateVertex(int cell) {
+    if (g[cell] != rhs[cell]) queue.push(calculateKey(cell));
+}
+
+void IncrementalSolver::cellChanged(Cell cell) {
+    if (!grid.inBounds(cell.r, cell.c)) return;
+    const int idx = grid.index(cell.r, cell.c);
+    const bool nowOpen = isOpenChar(grid.cells[idx]);
+    if (nowOpen == static_cast<bool>(open[idx])) return;
+
+    open[idx] = nowOpen;
+    rhs[idx] = idx == exitIdx ? (nowOpen ? 0 : INF) : bestSuccessor(idx);
+    updateVertex(idx);
+
+    // Every edge into the cell changed cost, so its neighbours' lookahead may too
+    int next[NUM_DIRECTIONS];
+    int count = neighborsOf(grid, idx, next);
+    for (int i = 0; i < count; i++) {
+        int neighbor = next[i];
+        if (neighbor == exitIdx || !open[neighbor]) continue;
+        rhs[neighbor] = bestSuccessor(neighbor);
+        updateVertex(neighbor);
+    }
+}
+
+void IncrementalSolver::moveStart(Cell start) {
+    if (!grid.inBounds(start.r, start.c)) return;
+    startIdx = grid.index(start.r, start.c);
+    km += heuristic(lastStart, startIdx);
+    lastStart = startIdx;
+}
+
+void IncrementalSolver::computeShortestPath() {
+    if (startIdx == -1 || exitIdx == -1 || !open[startIdx]) return;
+
+    auto lessKey = [](const Key& a, const Key& b) {
+        return get<0>(a) < get<0>(b) || (get<0>(a) == get<0>(b) && get<1>(a) < get<1>(b));
+    };
+
+    while (true) {
+        while (!queue.empty() && g[get<2>(queue.top())] == rhs[get<2>(queue.top())]) queue.pop();
+        if (queue.empty()) break;
+
+        const Key top = queue.top();
+        if (!lessKey(top, calculateKey(startIdx)) && rhs[startIdx] == g[startIdx]) break;
+
+        queue.pop();
+        const int cell = get<2>(top);
+        const Key current = calculateKey(cell);
+        if (lessKey(top, current)) {
+            queue.push(current);  // Queued before km or g / rhs changed
+            continue;
+        }
+        expandedCells++;
+
+        int next[NUM_DIRECTIONS];
+        int count = neighborsOf(grid, cell, next);
+
+        if (g[cell] > rhs[cell]) {
+            // Overconsistent: settle it and offer the shorter route to the neighbours
+            g[cell] = rhs[cell];
+            for (int i = 0; i < count; i++) {
+                int neighbor = next[i];
+                if (neighbor == exitIdx || !open[neighbor] || rhs[neighbor] <= g[cell] + 1) continue;
+                rhs[neighbor] = g[cell] + 1;
+                updateVertex(neighbor);
+            }
+        } else {
+            // Underconsistent: forget g and re-derive everyone who was routed through it
+            const int oldG = g[cell];
+            g[cell] = INF;
+            if (cell != exitIdx) rhs[cell] = bestSuccessor(cell);
+            updateVertex(cell);
+            for (int i = 0; i < count; i++) {
+                int neighbor = next[i];
+                if (neighbor == exitIdx || !open[neighbor] || rhs[neighbor] != oldG + 1) continue;
+                rhs[neighbor] = bestSuccessor(neighbor);
+                updateVertex(neighbor);
+            }
+        }
+    }
+
+    // Lazy deletion leaves stale entries behind; drop them once they dominate
+    if (queue.size() > 4 * static_cast<size_t>(grid.size()) + 64) rebuildQueue();
+}
+
+/**
+ * Helper function: Rebuild the queue from the inconsistent cells only
+ */
+void IncrementalSolver::rebuildQueue() {
+    vector<Key> keys;
+    for (int i = 0; i < grid.size(); i++) {
+        if (g[i] != rhs[i]) keys.push_back(calculateKey(i));
+    }
+    queue = decltype(queue)(greater<Key>(), move(keys));
+}
+
+int IncrementalSolver::distance() {
+    computeShortestPath();
+    if (startIdx == -1 || exitIdx == -1 || !open[startIdx] || g[startIdx] >= INF) return -1;
+    return g[startIdx];
+}
+
+std::vector<Cell> IncrementalSolver::path() {
+    const int steps = distance();
+    if (steps < 0) return vector<Cell>();
+
+    // Walk downhill in g; after computeShortestPath the g values along it are exact
+    vector<Cell> result;
+    result.reserve(steps + 1);
+    int cell = startIdx;
+    result.push_back(grid.cellAt(cell));
+    for (int step = 0; step < steps && cell != exitIdx; step++) {
+        int next[NUM_DIRECTIONS];
+        int count = neighborsOf(grid, cell, next);
+        int best = -1;
+        for (int i = 0; i < count; i++) {
+            if (open[next[i]] && (best == -1 || g[next[i]] < g[best])) best = next[i];
+        }
+        if (best == -1) return vector<Cell>();
+        cell = best;
+        result.push_back(grid.cellAt(cell));
+    }
+    return result;
+}
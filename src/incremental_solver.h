@@ -0,0 +1,83 @@
+#pragma once
+#include <vector>
+#include <tuple>
+#include <queue>
+#include <functional>
+#include "cell.h"
+#include "grid.h"
+
+/**
+ * Keeps the basic-BFS shortest path (doors are walls) of a changing dungeon
+ * up to date with D* Lite instead of re-solving from scratch after every edit.
+ *
+ * The search runs backwards from the exit, so g[cell] is the distance from
+ * cell to 'E'. When a cell changes, only the cells whose distance depends on
+ * it are re-expanded, so most edits cost a few hundred cells. A wall that
+ * cuts the only corridor of a perfect maze is the expensive case: every cell
+ * routed through it is re-derived. The start can also move (a walking
+ * player) without invalidating the search.
+ *
+ * The grid is edited in place by the caller, who then reports each edited
+ * cell with cellChanged(). Repairs are lazy: any number of edits can be
+ * reported before the next path() / distance() call does the work.
+ */
+class IncrementalSolver {
+public:
+    /**
+     * Solves grid from grid.start to grid.exit. The grid must outlive the
+     * solver and keep its dimensions. Takes the Grid itself rather than a
+     * GridView, because reset() re-reads start and exit after edits.
+     */
+    explicit IncrementalSolver(const Grid& grid);
+
+    /**
+     * Reports that grid cell has been edited. Cheap if the edit does not
+     * change passability (for example a key being picked up).
+     */
+    void cellChanged(Cell cell);
+
+    /**
+     * Moves the start, e.g. after the player has walked along the path.
+     * Editing 'E' or re-placing it needs reset().
+     */
+    void moveStart(Cell start);
+
+    /**
+     * Discards the search and starts again from grid.start / grid.exit.
+     */
+    void reset();
+
+    /**
+     * Number of steps on a shortest path from the start to the exit, or -1.
+     */
+    int distance();
+
+    /**
+     * Shortest path from the start to the exit (inclusive), or empty.
+     */
+    std::vector<Cell> path();
+
+    // Cells expanded by the repairs since construction or the last reset()
+    size_t expanded() const { return expandedCells; }
+
+private:
+    using Key = std::tuple<int, int, int>;  // (g-or-rhs + h + km, g-or-rhs, cell)
+
+    int heuristic(int a, int b) const;
+    Key calculateKey(int cell) const;
+    int bestSuccessor(int cell) const;
+    void updateVertex(int cell);
+    void computeShortestPath();
+    void rebuildQueue();
+
+    const Grid& grid;
+    std::vector<int> g;              // Settled distance to the exit
+    std::vector<int> rhs;            // One-step lookahead distance to the exit
+    std::vector<unsigned char> open; // Passability as of the last cellChanged()
+    std::priority_queue<Key, std::vector<Key>, std::greater<Key>> queue;  // Lazy: stale entries skipped
+    int startIdx = -1;
+    int exitIdx = -1;
+    int lastStart = -1;              // Start when km was last updated
+    int km = 0;                      // Accumulated heuristic drift from moveStart()
+    size_t expandedCells = 0;
+};
@@ -0,0 +1,180 @@
+/**
+ * Dungeon Pathfinder - Key Graph Solver
+ *
+ * Two-level key-door pathfinding: BFS between points of interest builds a
+ * small weighted graph, then Dijkstra runs over (POI, keyMask) states.
+ */
+
+#include "key_graph.h"
+#include "solver.h"
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+using namespace std;
+
+/**
+ * Helper function: S, E, keys and doors are points of interest
+ */
+static bool isPoiChar(char cell) {
+    return cell == 'S' || cell == 'E' || (cellClass(cell) & (CELL_KEY | CELL_DOOR));
+}
+
+/**
+ * Helper function: Floor-only BFS from source. Plain cells are expanded,
+ * POI cells are reported through onPoi(cellIndex, steps) but not expanded.
+ * stamp marks cells seen in this run (stamp == runId), so the buffers can be
+ * reused across runs without clearing. parent is filled for every seen cell.
+ */
+static void floorBfs(const GridView& grid, int source, int runId, vector<int>& stamp,
+                     vector<int>& dist, vector<int>& parent, vector<int>& frontier,
+                     const function<bool(int, int)>& onPoi) {
+    const int stride = grid.stride;
+    const char* cells = grid.cells;
+    int head = 0, tail = 0;
+
+    frontier[tail++] = source;
+    stamp[source] = runId;
+    dist[source] = 0;
+    parent[source] = -1;
+
+    while (head < tail) {
+        int current = frontier[head++];
+        int col = current % stride;
+        int neighbors[NUM_DIRECTIONS];
+        int count = 0;
+
+        if (current >= stride) neighbors[count++] = current - stride;
+        if (current + stride < grid.size()) neighbors[count++] = current + stride;
+        if (col > 0) neighbors[count++] = current - 1;
+        if (col + 1 < grid.cols) neighbors[count++] = current + 1;
+
+        for (int i = 0; i < count; i++) {
+            int next = neighbors[i];
+            if (cells[next] == '#' || stamp[next] == runId) continue;
+
+            stamp[next] = runId;
+            dist[next] = dist[current] + 1;
+            parent[next] = current;
+
+            if (isPoiChar(cells[next])) {
+                if (onPoi(next, dist[next])) return;  // Caller found what it wanted
+            } else {
+                frontier[tail++] = next;
+            }
+        }
+    }
+}
+
+KeyGraph buildKeyGraph(const GridView& grid) {
+    KeyGraph graph;
+
+    unordered_map<int, int> poiOf;
+    for (int r = 0; r < grid.rows; r++) {
+        for (int c = 0; c < grid.cols; c++) {
+            int idx = grid.index(r, c);
+            if (!isPoiChar(grid.cells[idx])) continue;
+
+            int poi = static_cast<int>(graph.poiCells.size());
+            poiOf[idx] = poi;
+            graph.poiCells.push_back(idx);
+            if (grid.cells[idx] == 'S' && graph.startPoi == -1) graph.startPoi = poi;
+            if (grid.cells[idx] == 'E' && graph.exitPoi == -1) graph.exitPoi = poi;
+        }
+    }
+    graph.edges.resize(graph.poiCells.size());
+
+    vector<int> stamp(grid.size(), -1), dist(grid.size()), parent(grid.size()), frontier(grid.size());
+    for (int poi = 0; poi < static_cast<int>(graph.poiCells.size()); poi++) {
+        floorBfs(grid, graph.poiCells[poi], poi, stamp, dist, parent, frontier,
+                 [&](int cell, int steps) {
+                     graph.edges[poi].push_back({poiOf[cell], steps});
+                     return false;
+                 });
+    }
+
+    return graph;
+}
+
+std::vector<Cell> bfsPathKeysCompressed(const GridView& grid) {
+    return bfsPathKeysCompressed(grid, buildKeyGraph(grid));
+}
+
+std::vector<Cell> bfsPathKeysCompressed(const GridView& grid, const KeyGraph& graph) {
+    if (graph.startPoi == -1 || graph.exitPoi == -1) {
+        return vector<Cell>();
+    }
+
+    // Dijkstra over (POI, keyMask): state = poi * 64 + mask
+    const int MASKS = 64;
+    const int stateCount = static_cast<int>(graph.poiCells.size()) * MASKS;
+    vector<int> best(stateCount, INT_MAX);
+    vector<int> from(stateCount, -1);
+
+    using Entry = pair<int, int>;  // (distance, state)
+    priority_queue<Entry, vector<Entry>, greater<Entry>> open;
+
+    const int startState = graph.startPoi * MASKS;
+    best[startState] = 0;
+    open.push({0, startState});
+
+    int goal = -1;
+    while (!open.empty()) {
+        auto [distance, state] = open.top();
+        open.pop();
+        if (distance != best[state]) continue;  // Stale entry
+
+        int poi = state / MASKS;
+        int mask = state % MASKS;
+        if (poi == graph.exitPoi) {
+            goal = state;
+            break;
+        }
+
+        for (const auto& [target, steps] : graph.edges[poi]) {
+            char cell = grid.cells[graph.poiCells[target]];
+            if (cell >= 'A' && cell <= 'F' && cell != 'E' && !canPassDoor(cell, mask)) continue;
+
+            int nextState = target * MASKS + collectKey(cell, mask);
+            int nextDist = distance + steps;
+            if (nextDist < best[nextState]) {
+                best[nextState] = nextDist;
+                from[nextState] = state;
+                open.push({nextDist, nextState});
+            }
+        }
+    }
+
+    if (goal == -1) {
+        return vector<Cell>();
+    }
+
+    // Winning route as a list of POIs, start first
+    vector<int> route;
+    for (int state = goal; state != -1; state = from[state]) {
+        route.push_back(graph.poiCells[state / MASKS]);
+    }
+    reverse(route.begin(), route.end());
+
+    // Expand each POI-to-POI leg with the same floor-only BFS used to build
+    // the graph, so every leg has exactly the edge's length
+    vector<int> stamp(grid.size(), -1), dist(grid.size()), parent(grid.size()), frontier(grid.size());
+    vector<Cell> path;
+    path.push_back(grid.cellAt(route[0]));
+
+    for (size_t leg = 0; leg + 1 < route.size(); leg++) {
+        int target = route[leg + 1];
+        floorBfs(grid, route[leg], static_cast<int>(leg), stamp, dist, parent, frontier,
+                 [&](int cell, int) { return cell == target; });
+
+        size_t legStart = path.size();
+        for (int idx = target; idx != route[leg]; idx = parent[idx]) {
+            path.push_back(grid.cellAt(idx));
+        }
+        reverse(path.begin() + legStart, path.end());
+    }
+
+    return path;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include "cell.h"
+#include "grid.h"
+
+/**
+ * Compressed view of a key-door dungeon for the two-level solver.
+ *
+ * Points of interest (POIs) are S, E and every key ('a'-'f') and door ('A'-'F')
+ * cell. Two POIs are connected when one can walk between them over plain floor
+ * only; the edge weight is the number of steps. Any S-E route in the dungeon is
+ * a sequence of such edges, so searching (POI, keyMask) states on this graph is
+ * equivalent to the full (cell, keyMask) BFS but with far fewer states.
+ */
+struct KeyGraph {
+    std::vector<int> poiCells;                              // Flat grid index of each POI
+    std::vector<std::vector<std::pair<int, int>>> edges;    // edges[p] = (target POI, steps)
+    int startPoi = -1;
+    int exitPoi = -1;
+};
+
+/**
+ * Builds the POI graph with one floor-only BFS from every POI.
+ *
+ * @param grid Flat dungeon with precomputed start and exit positions
+ * @return Graph over S, E, keys and doors; startPoi/exitPoi are -1 if missing
+ */
+KeyGraph buildKeyGraph(const GridView& grid);
+
+/**
+ * Two-level key-door solver. Runs Dijkstra over (POI, keyMask) states of the
+ * KeyGraph, then expands only the winning POI-to-POI legs back into cells.
+ * Returns a path as short as bfsPathKeys. Best on large maps with few keys,
+ * where the search shrinks from cells * 64 states to about POIs * 64.
+ *
+ * @param grid Flat dungeon with precomputed start and exit positions
+ * @return Vector of Cell coordinates from S to E, or empty if no path exists
+ */
+std::vector<Cell> bfsPathKeysCompressed(const GridView& grid);
+
+/**
+ * Same as above with a graph built earlier by buildKeyGraph(grid), for
+ * callers that solve the same dungeon repeatedly.
+ */
+std::vector<Cell> bfsPathKeysCompressed(const GridView& grid, const KeyGraph& graph);
@@ -2,9 +2,29 @@
 #include <vector>
 #include <string>
 #include <cassert>
+#include <chrono>
+#include <random>
+#include <queue>
+#include <cstring>
+#include <cstdlib>
+#include <unordered_set>
+#include <sstream>
+#include <fstream>
+#include <memory>
 #include "generator.h"
 #include "solver.h"
 #include "cell.h"
+#include "key_graph.h"
+#include "dungeon_index.h"
+#include "bit_grid.h"
+#include "dungeon_file.h"
+#include "dungeon_text.h"
+#include "incremental_solver.h"
+#include "distance_field.h"
+#include "hierarchical_solver.h"
+#include "solve_service.h"
+#include "solution_cache.h"
+#include "connectivity.h"
 
 using namespace std;
 
@@ -13,40 +33,19 @@ using namespace std;
  * Shows walls (#), open spaces ( ), start (S), exit (E), keys (a-f), and doors (A-F).
  */
 void printDungeon(const vector<string>& dungeon, const string& title = "") {
-    if (!title.empty()) {
-        cout << title << ":" << endl;
-    }
-    
-    for (const string& row : dungeon) {
-        cout << row << endl;
-    }
-    cout << endl;
+    DungeonWriter(cout).write(dungeon, title);
 }
 
 /**
  * Prints a dungeon with the solution path marked using '*' characters.
  * The start 'S' and exit 'E' positions are preserved.
  */
-void printDungeonWithPath(vector<string> dungeon, const vector<Cell>& path, const string& title = "") {
-    if (!title.empty()) {
-        cout << title << ":" << endl;
-    }
-    
-    // Mark the path with '*' characters, but preserve S and E
-    for (const Cell& cell : path) {
-        if (cell.r >= 0 && cell.r < (int)dungeon.size() && 
-            cell.c >= 0 && cell.c < (int)dungeon[0].size()) {
-            char current = dungeon[cell.r][cell.c];
-            if (current != 'S' && current != 'E') {
-                dungeon[cell.r][cell.c] = '*';
-            }
-        }
-    }
-    
-    for (const string& row : dungeon) {
-        cout << row << endl;
-    }
-    cout << endl;
+void printDungeonWithPath(const GridView& dungeon, const vector<Cell>& path, const string& title = "") {
+    DungeonWriter(cout).writeWithPath(dungeon, path, title);
+}
+
+void printDungeonWithPath(const vector<string>& dungeon, const vector<Cell>& path, const string& title = "") {
+    DungeonWriter(cout).writeWithPath(dungeon, path, title);
 }
 
 /**
@@ -55,50 +54,38 @@ void printDungeonWithPath(vector<string> dungeon, const vector<Cell>& path, cons
  * 2. Each step moves to an adjacent cell
  * 3. No step goes through walls
  * 4. Path is non-empty if start and exit exist
+ *
+ * One pass over the path with the checks folded into a flag instead of early
+ * returns, so the loop has no data-dependent branches.
  */
-bool validatePath(const vector<string>& dungeon, const vector<Cell>& path) {
-    if (path.empty()) {
+bool validatePath(const GridView& dungeon, const vector<Cell>& path) {
+    if (path.empty() || dungeon.start.r == -1 || dungeon.exit.r == -1) {
         return false;
     }
-    
-    Cell start = findPosition(dungeon, 'S');
-    Cell exit = findPosition(dungeon, 'E');
-    
-    if (start.r == -1 || exit.r == -1) {
-        return false; 
-    }
-    
-    if (path[0] != start || path[path.size() - 1] != exit) {
+    if (path[0] != dungeon.start || path[path.size() - 1] != dungeon.exit) {
         return false;
     }
-    
+
+    bool valid = true;
     for (size_t i = 0; i < path.size(); i++) {
         const Cell& cell = path[i];
-        
-        if (cell.r < 0 || cell.r >= (int)dungeon.size() || 
-            cell.c < 0 || cell.c >= (int)dungeon[0].size()) {
-            return false;
-        }
-        
-        char cellChar = dungeon[cell.r][cell.c];
-        if (cellChar == '#') {
-            return false;
-        }
-        
-        if (i > 0) {
-            const Cell& prev = path[i - 1];
-            int dr = abs(cell.r - prev.r);
-            int dc = abs(cell.c - prev.c);
-            
-            if ((dr == 1 && dc == 0) || (dr == 0 && dc == 1)) {
-                // Valid move
-            } else {
-                return false; // Invalid move (diagonal, too far, or no movement)
-            }
-        }
+        const Cell& prev = path[i > 0 ? i - 1 : 0];
+        bool inside = static_cast<unsigned>(cell.r) < static_cast<unsigned>(dungeon.rows) &&
+                      static_cast<unsigned>(cell.c) < static_cast<unsigned>(dungeon.cols);
+        char cellChar = dungeon.cells[inside ? dungeon.index(cell.r, cell.c) : 0];
+        int step = abs(cell.r - prev.r) + abs(cell.c - prev.c);
+
+        // The first cell is compared with itself (step 0); every later one must move exactly 1
+        valid &= inside & (cellChar != '#') & (step == (i > 0));
     }
-    
-    return true;
+    return valid;
+}
+
+/**
+ * Same checks on a vector<string> dungeon, which is flattened once first.
+ */
+bool validatePath(const vector<string>& dungeon, const vector<Cell>& path) {
+    return validatePath(Grid(dungeon), path);
 }
 
 /**
@@ -217,15 +204,9 @@ bool testKeyDoorPathfinding() {
     vector<string> dungeon = createTestDungeonKeys();
     printDungeon(dungeon, "Key-Door Test Dungeon");
 
-#ifdef IMPLEMENT_OPTIONAL_FUNCTIONS
-    // Optional intermediate function test (only runs if student enables it)
-    cout << "Step 1: [OPTIONAL] Counting reachable keys (ignoring doors)..." << endl;
-    int reachableKeys = countReachableKeys(dungeon);
-    cout << "Reachable keys without considering doors: " << reachableKeys << endl << endl;
-#else
-    cout << "Step 1: [OPTIONAL] Key counting function not implemented" << endl;
-    cout << "To enable: uncomment #define IMPLEMENT_OPTIONAL_FUNCTIONS in solver.h" << endl << endl;
-#endif
+    cout << "Step 1: Counting reachable keys (ignoring doors)..." << endl;
+    int reachableKeyCount = countReachableKeys(dungeon);
+    cout << "Reachable keys without considering doors: " << reachableKeyCount << endl << endl;
     
     // Test basic BFS (should fail due to locked door)
     cout << "Step 2: [REQUIRED] Testing basic BFS (should fail due to locked door)..." << endl;
@@ -336,65 +317,2050 @@ bool testDungeonGeneration() {
 }
 
 /**
- * Main function that runs all test cases.
+ * Test that large dungeons generate without exhausting the call stack
+ * and are still solvable.
  */
-int main() {
-    cout << "Testing Dungeon Pathfinder Algorithms" << endl;
-    cout << "================================================" << endl;
-    cout << "[TIP] If functions hang or fail, check for TODO messages!" << endl;
-    cout << "[TIP] Safety mechanisms will prevent infinite loops and provide guidance." << endl << endl;
-    
-    // Run all test cases and track progress
-    int totalTests = 5;
-    int passedTests = 0;
-    
-    cout << "Running test 1/5..." << endl;
-    if (testBasicPathfinding()) passedTests++;
-    
-    cout << "Running test 2/5..." << endl;
-    if (testComplexPathfinding()) passedTests++;
-    
-    cout << "Running test 3/5..." << endl;
-    if (testKeyDoorPathfinding()) passedTests++;
-    
-    cout << "Running test 4/5..." << endl;
-    if (testUnsolvableDungeon()) passedTests++;
-    
-    cout << "Running test 5/5..." << endl;
-    if (testDungeonGeneration()) passedTests++;
-    
-    // Display test progress summary
-    cout << "================================================" << endl;
-    cout << "TEST PROGRESS SUMMARY" << endl;
-    cout << "================================================" << endl;
-    cout << "Tests passed: " << passedTests << "/" << totalTests;
-    
-    if (passedTests == totalTests) {
-        cout << " [EXCELLENT! All tests passed!]" << endl;
-    } else if (passedTests >= totalTests * 0.8) {
-        cout << " [GREAT! Almost there!]" << endl;
-    } else if (passedTests >= totalTests * 0.5) {
-        cout << " [GOOD! Making progress!]" << endl;
-    } else if (passedTests > 0) {
-        cout << " [GETTING STARTED! Keep going!]" << endl;
+bool testLargeDungeonGeneration() {
+    cout << "=== Large Dungeon Generation Test ===" << endl;
+
+    cout << "Generating 4001x4001 dungeon..." << endl;
+    Grid dungeon = generateDungeonGrid(4001, 4001, 0);
+
+    bool success = false;
+    if (dungeon.start.r == -1 || dungeon.exit.r == -1) {
+        cout << "[ERROR] Large dungeon is missing start (S) or exit (E)" << endl;
     } else {
-        cout << " [START HERE! Complete the TODOs above.]" << endl;
+        vector<Cell> path = bfsPath(dungeon);
+        if (!path.empty()) {
+            cout << "[OK] Large dungeon is solvable! Path length: " << path.size() << endl;
+            success = true;
+        } else {
+            cout << "[ERROR] No path found in large generated dungeon!" << endl;
+        }
     }
-    cout << endl;
-    cout << endl;
-    cout << "Implementation Requirements:" << endl;
-    cout << "================================================" << endl;
-    cout << "[REQUIRED] Complete the TODOs in generator.cpp for maze generation" << endl;
-    cout << "[REQUIRED] Complete the basic BFS in solver.cpp for pathfinding" << endl;
-    cout << "[REQUIRED] Complete the 3 TODOs in bfsPathKeys() for key-door mechanics" << endl;
-    cout << endl;
-    cout << "Optional Challenges:" << endl;
-    cout << "================================================" << endl;
-#ifdef IMPLEMENT_OPTIONAL_FUNCTIONS
-    cout << "[ENABLED] countReachableKeys() function - implement for bitmask practice" << endl;
-#else
-    cout << "[DISABLED] countReachableKeys() function - uncomment #define in solver.h to enable" << endl;
-#endif
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that seeded generation is reproducible and that different seeds
+ * (and engines) give different dungeons.
+ */
+bool testReproducibleGeneration() {
+    cout << "=== Reproducible Generation Test ===" << endl;
+
+    Grid first = generateDungeonGrid(41, 41, 20, 42);
+    Grid again = generateDungeonGrid(41, 41, 20, 42);
+    Grid other = generateDungeonGrid(41, 41, 20, 43);
+
+    BasicGeneratorContext<mt19937_64> mtContext(42);
+    Grid mersenne = generateDungeonGrid(41, 41, 20, mtContext);
+
+    bool success = false;
+    if (first.cells != again.cells) {
+        cout << "[ERROR] Same seed produced different dungeons!" << endl;
+    } else if (first.cells == other.cells || first.cells == mersenne.cells) {
+        cout << "[ERROR] Different seeds/engines produced identical dungeons!" << endl;
+    } else if (bfsPath(first).empty() || bfsPath(mersenne).empty()) {
+        cout << "[ERROR] Seeded dungeon is not solvable!" << endl;
+    } else {
+        cout << "[OK] Seed 42 reproduces the same dungeon; other seeds differ" << endl;
+        success = true;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that the parallel batch generator matches single-dungeon generation
+ * with the per-index seeds and that every dungeon in the batch is solvable.
+ */
+bool testBatchGeneration() {
+    cout << "=== Batch Generation Test ===" << endl;
+
+    const int count = 64;
+    vector<Grid> batch = generateDungeons(count, 31, 31, 20, 7);
+
+    bool success = true;
+    for (int i = 0; i < count && success; i++) {
+        Grid single = generateDungeonGrid(31, 31, 20, batchDungeonSeed(7, i));
+        if (batch[i].cells != single.cells) {
+            cout << "[ERROR] Batch dungeon " << i << " differs from its seeded single generation!" << endl;
+            success = false;
+        } else if (bfsPath(batch[i]).empty()) {
+            cout << "[ERROR] Batch dungeon " << i << " is not solvable!" << endl;
+            success = false;
+        }
+    }
+    if (success) {
+        cout << "[OK] " << count << " dungeons generated on " << ThreadPool::shared().size()
+             << " thread(s), all reproducible and solvable" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that the batch solver returns the same shortest paths as solving
+ * each dungeon on its own.
+ */
+bool testBatchSolving() {
+    cout << "=== Batch Solving Test ===" << endl;
+
+    vector<Grid> dungeons = generateDungeons(128, 41, 41, 20, 11);
+    vector<vector<Cell>> paths = solveBatch(dungeons, SolveMode::Basic);
+
+    bool success = true;
+    for (size_t i = 0; i < dungeons.size() && success; i++) {
+        if (!validatePath(dungeons[i].toStrings(), paths[i]) ||
+            paths[i].size() != bfsPath(dungeons[i]).size()) {
+            cout << "[ERROR] Batch path " << i << " is invalid or not shortest!" << endl;
+            success = false;
+        }
+    }
+    if (success) {
+        cout << "[OK] " << dungeons.size() << " dungeons solved in one batch, all paths valid" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that bidirectional BFS finds paths exactly as short as bfsPath,
+ * including on the hand-made dungeons and an unsolvable one.
+ */
+bool testBidirectionalPathfinding() {
+    cout << "=== Bidirectional BFS Test ===" << endl;
+
+    vector<Grid> dungeons = {
+        Grid(createTestDungeon1()), Grid(createTestDungeon2()), Grid(createUnsolvableDungeon())
+    };
+    for (int roomRate : {0, 20, 60}) {
+        vector<Grid> batch = generateDungeons(20, 61, 61, roomRate, 21 + roomRate);
+        dungeons.insert(dungeons.end(), batch.begin(), batch.end());
+    }
+
+    bool success = true;
+    for (size_t i = 0; i < dungeons.size() && success; i++) {
+        vector<Cell> expected = bfsPath(dungeons[i]);
+        vector<Cell> path = bfsPathBidirectional(dungeons[i]);
+        if (path.size() != expected.size() ||
+            (!path.empty() && !validatePath(dungeons[i].toStrings(), path))) {
+            cout << "[ERROR] Bidirectional result differs on dungeon " << i
+                 << " (" << path.size() << " vs " << expected.size() << ")" << endl;
+            success = false;
+        }
+    }
+    if (success) {
+        cout << "[OK] Bidirectional BFS matched bfsPath on " << dungeons.size() << " dungeons" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that A* returns paths of the same length as bfsPath while expanding
+ * no more cells.
+ */
+bool testAStarPathfinding() {
+    cout << "=== A* Pathfinding Test ===" << endl;
+
+    vector<Grid> dungeons = {
+        Grid(createTestDungeon1()), Grid(createTestDungeon2()), Grid(createUnsolvableDungeon())
+    };
+    for (int roomRate : {0, 20, 60}) {
+        vector<Grid> batch = generateDungeons(20, 61, 61, roomRate, 31 + roomRate);
+        dungeons.insert(dungeons.end(), batch.begin(), batch.end());
+    }
+
+    SolverContext bfsContext, astarContext;
+    size_t bfsExplored = 0, astarExplored = 0;
+    bool success = true;
+    for (size_t i = 0; i < dungeons.size() && success; i++) {
+        vector<Cell> expected = bfsPath(dungeons[i], bfsContext);
+        vector<Cell> path = astarPath(dungeons[i], astarContext);
+        bfsExplored += bfsContext.explored;
+        astarExplored += astarContext.explored;
+        if (path.size() != expected.size() ||
+            (!path.empty() && !validatePath(dungeons[i].toStrings(), path))) {
+            cout << "[ERROR] A* result differs on dungeon " << i
+                 << " (" << path.size() << " vs " << expected.size() << ")" << endl;
+            success = false;
+        }
+    }
+    if (success) {
+        cout << "[OK] A* matched bfsPath on " << dungeons.size() << " dungeons, expanding "
+             << astarExplored << " cells vs " << bfsExplored << " for BFS" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that dungeons written to a binary file map back unchanged and solve
+ * straight from the packed cells.
+ */
+bool testDungeonFile() {
+    cout << "=== Binary Dungeon File Test ===" << endl;
+
+    vector<Grid> dungeons = {
+        Grid(createTestDungeon1()), Grid(createTestDungeonKeys()), Grid(createUnsolvableDungeon()),
+        generateDungeonGrid(101, 203, 0, 15), generateDungeonGrid(64, 65, 40, 16)
+    };
+    const string path = "dungeon_file_test.bin";
+
+    bool success = writeDungeonFile(path, dungeons);
+    DungeonFile file;
+    if (!success || !file.open(path) || file.size() != dungeons.size()) {
+        cout << "[ERROR] Could not write and reopen " << path << endl;
+        success = false;
+    }
+
+    SolverContext ctx;
+    for (size_t i = 0; i < file.size() && success; i++) {
+        PackedDungeon packed = file.dungeon(i);
+        Grid unpacked = packed.toGrid();
+        int expectedBits = i == 1 ? 4 : 2;
+        if (!packed.valid() || packed.bitsPerCell != expectedBits || unpacked.cells != dungeons[i].cells ||
+            unpacked.start != dungeons[i].start || unpacked.exit != dungeons[i].exit) {
+            cout << "[ERROR] Dungeon " << i << " did not round-trip" << endl;
+            success = false;
+            continue;
+        }
+
+        vector<Cell> expected = bfsPath(dungeons[i]);
+        vector<Cell> solved = bfsPath(packed, ctx);
+        if (solved.size() != expected.size() || !equal(solved.begin(), solved.end(), expected.begin())) {
+            cout << "[ERROR] Packed BFS differs on dungeon " << i << endl;
+            success = false;
+        }
+    }
+    if (success && file.dungeon(1).poiCount != 4) {
+        cout << "[ERROR] Expected 4 keys and doors, got " << file.dungeon(1).poiCount << endl;
+        success = false;
+    }
+    if (success && (file.dungeon(file.size()).valid() || DungeonFile().open("missing_dungeon_file.bin"))) {
+        cout << "[ERROR] Invalid record or missing file was accepted" << endl;
+        success = false;
+    }
+    file.close();
+
+    // Corrupt record 0's start row (8 bytes into its record header) past the map
+    if (success) {
+        fstream raw(path, ios::in | ios::out | ios::binary);
+        uint64_t offset = 0;
+        raw.seekg(16);
+        raw.read(reinterpret_cast<char*>(&offset), sizeof(offset));
+        int32_t badRow = dungeons[0].rows + 5;
+        raw.seekp(static_cast<streamoff>(offset + 8));
+        raw.write(reinterpret_cast<const char*>(&badRow), sizeof(badRow));
+        raw.close();
+        if (!file.open(path) || file.dungeon(0).valid() || !file.dungeon(1).valid()) {
+            cout << "[ERROR] Record with an out-of-bounds start was accepted" << endl;
+            success = false;
+        }
+        file.close();
+    }
+    remove(path.c_str());
+
+    if (success) {
+        cout << "[OK] 2-bit and 4-bit dungeons round-trip and solve from the mapping" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that dungeons written with DungeonWriter read back unchanged through
+ * DungeonReader, including chunk boundaries inside rows, CRLF line endings
+ * and ragged rows.
+ */
+bool testDungeonTextStream() {
+    cout << "=== ASCII Dungeon Stream Test ===" << endl;
+
+    vector<Grid> dungeons = {
+        Grid(createTestDungeon1()), Grid(createTestDungeonKeys()),
+        generateDungeonGrid(31, 57, 20, 16), generateDungeonGrid(9, 9, 0, 3)
+    };
+    ostringstream text;
+    {
+        DungeonWriter writer(text, 64);
+        for (size_t i = 0; i < dungeons.size(); i++) {
+            writer.write(dungeons[i], i % 2 == 0 ? "Dungeon " + to_string(i) : "");
+        }
+    }
+
+    bool success = true;
+    istringstream in(text.str());
+    DungeonReader reader(in, 7);
+    Grid parsed;
+    string title;
+    size_t count = 0;
+    for (; reader.next(parsed, &title); count++) {
+        if (count >= dungeons.size()) break;
+        string expectedTitle = count % 2 == 0 ? "Dungeon " + to_string(count) : "";
+        if (parsed.rows != dungeons[count].rows || parsed.cols != dungeons[count].cols ||
+            parsed.cells != dungeons[count].cells || parsed.start != dungeons[count].start ||
+            title != expectedTitle) {
+            cout << "[ERROR] Dungeon " << count << " did not round-trip" << endl;
+            success = false;
+        }
+    }
+    if (count != dungeons.size()) {
+        cout << "[ERROR] Read " << count << " dungeons, expected " << dungeons.size() << endl;
+        success = false;
+    }
+
+    // CRLF, extra blank lines, short rows padded and long rows cut
+    istringstream crlf("\r\n\r\n#####\r\n#S E\r\n#####xx\r\n\r\n\r\n");
+    DungeonReader crlfReader(crlf);
+    if (!crlfReader.next(parsed) || parsed.rows != 3 || parsed.cols != 5 ||
+        string(parsed.cells.begin(), parsed.cells.end()) != "######S E######" ||
+        parsed.exit != Cell(1, 3) || crlfReader.next(parsed)) {
+        cout << "[ERROR] CRLF / ragged input parsed incorrectly" << endl;
+        success = false;
+    }
+
+    // The path overlay matches the old per-character printer
+    vector<Cell> path = bfsPath(dungeons[0]);
+    ostringstream drawn;
+    DungeonWriter(drawn).writeWithPath(dungeons[0], path, "Solution");
+    vector<string> expected = createTestDungeon1();
+    for (const Cell& cell : path) {
+        if (expected[cell.r][cell.c] != 'S' && expected[cell.r][cell.c] != 'E') expected[cell.r][cell.c] = '*';
+    }
+    string expectedText = "Solution:\n";
+    for (const string& row : expected) expectedText += row + "\n";
+    if (drawn.str() != expectedText + "\n") {
+        cout << "[ERROR] Path overlay output differs" << endl;
+        success = false;
+    }
+
+    if (success) {
+        cout << "[OK] Dungeon text streams round-trip through the chunked reader" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that one SolverContext reused across many solves of different sizes
+ * (and across a stamp wraparound) gives the same answers as fresh contexts.
+ */
+bool testSolverContextReuse() {
+    cout << "=== Solver Context Reuse Test ===" << endl;
+
+    vector<Grid> dungeons;
+    for (int i = 0; i < 12; i++) {
+        int size = 11 + 20 * (i % 4);
+        dungeons.push_back(generateDungeonGrid(size, size + 6, 20 * (i % 3), 17 + i));
+    }
+    dungeons.push_back(Grid(createUnsolvableDungeon()));
+
+    bool success = true;
+    SolverContext shared;
+    for (int round = 0; round < 2 && success; round++) {
+        // Second round starts right below the wraparound point
+        if (round == 1) shared.nextStamp = UINT32_MAX - 3;
+
+        for (size_t i = 0; i < dungeons.size() && success; i++) {
+            const Grid& dungeon = dungeons[i];
+            vector<Cell> expected = bfsPath(dungeon);
+            bool same = bfsPath(dungeon, shared).size() == expected.size() &&
+                        bfsPathBidirectional(dungeon, shared).size() == expected.size() &&
+                        astarPath(dungeon, shared).size() == expected.size() &&
+                        bfsPath(dungeon.toStrings(), shared).size() == expected.size();
+            if (!same) {
+                cout << "[ERROR] Reused context gave a different path on dungeon " << i
+                     << " (round " << round << ")" << endl;
+                success = false;
+            }
+        }
+    }
+    if (success && shared.nextStamp > 100) {
+        cout << "[ERROR] Stamp counter did not wrap around" << endl;
+        success = false;
+    }
+    if (success) {
+        cout << "[OK] Reused context matches fresh solves, including after stamp wraparound" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test every key-count specialization of bfsPathKeys (0 to 6 distinct keys),
+ * including a door whose key is missing, against the compressed solver.
+ */
+bool testKeyCountSpecializations() {
+    cout << "=== Key Count Specialization Test ===" << endl;
+
+    bool success = true;
+    mt19937 rng(18);
+    for (int keys = 0; keys <= 6 && success; keys++) {
+        Grid dungeon = generateDungeonGrid(41, 61, 20, 18 + keys);
+        vector<Cell> basic = bfsPath(dungeon);
+
+        // Door 'F' on the shortest path; it only opens when key 'f' exists
+        Cell door = basic[basic.size() / 2];
+        dungeon.at(door.r, door.c) = 'F';
+        for (int placed = 0; placed < keys;) {
+            int r = rng() % dungeon.rows, c = rng() % dungeon.cols;
+            if (dungeon.at(r, c) != ' ') continue;
+            dungeon.at(r, c) = static_cast<char>('a' + placed++);
+        }
+
+        vector<Cell> path = bfsPathKeys(dungeon);
+        vector<Cell> expected = bfsPathKeysCompressed(dungeon);
+        if (path.size() != expected.size() || (!path.empty() && !validatePath(dungeon.toStrings(), path))) {
+            cout << "[ERROR] " << keys << " keys: bfsPathKeys length " << path.size()
+                 << ", compressed solver " << expected.size() << endl;
+            success = false;
+        }
+    }
+    if (success) {
+        cout << "[OK] All key-count specializations agree with the compressed solver" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Helper function: Trace hook for testSolverStats, counts samples
+ */
+static void countTraceSample(const TraceSample& sample, void* user) {
+    if (sample.solver) (*static_cast<int*>(user))++;
+}
+
+/**
+ * Test that the vector<string> solvers stay silent and, in builds with
+ * ENABLE_SOLVER_STATS, fill SolverContext::stats and call the trace hook.
+ */
+bool testSolverStats() {
+    cout << "=== Solver Stats Test ===" << endl;
+
+    bool success = true;
+    vector<string> keyDungeon = {
+        "#########",
+        "#S  a  A#",
+        "# ##### #",
+        "#   b  B#",
+        "####### #",
+        "#E      #",
+        "#########"
+    };
+
+    // The solvers must not write to stdout
+    ostringstream captured;
+    streambuf* saved = cout.rdbuf(captured.rdbuf());
+    vector<Cell> basic = bfsPath(generateDungeon(21, 41, 20));
+    vector<Cell> keyed = bfsPathKeys(keyDungeon);
+    cout.rdbuf(saved);
+    if (!captured.str().empty() || basic.empty() || keyed.empty()) {
+        cout << "[ERROR] Solvers printed " << captured.str().size() << " bytes" << endl;
+        success = false;
+    }
+
+    if (SOLVER_STATS_ENABLED && success) {
+        SolverContext ctx;
+        int samples = 0;
+        ctx.trace.hook = countTraceSample;
+        ctx.trace.user = &samples;
+        ctx.trace.interval = 4;
+
+        Grid grid(keyDungeon);
+        bfsPathKeys(grid, ctx);
+        size_t perMask = 0;
+        for (size_t count : ctx.stats.statesPerMask) perMask += count;
+        if (ctx.stats.expanded != ctx.explored || perMask != ctx.explored ||
+            ctx.stats.peakQueue == 0 || ctx.stats.statesPerMask[0] == perMask ||
+            samples != static_cast<int>(ctx.explored / 4)) {
+            cout << "[ERROR] Key stats: expanded " << ctx.stats.expanded << ", per-mask sum "
+                 << perMask << ", peak queue " << ctx.stats.peakQueue << ", samples " << samples << endl;
+            success = false;
+        }
+
+        samples = 0;
+        bfsPath(grid, ctx);
+        if (ctx.stats.expanded != ctx.explored || ctx.stats.statesPerMask[0] != ctx.explored ||
+            ctx.stats.statesPerMask[1] != 0 || samples != static_cast<int>(ctx.explored / 4)) {
+            cout << "[ERROR] bfsPath stats: expanded " << ctx.stats.expanded
+                 << ", explored " << ctx.explored << ", samples " << samples << endl;
+            success = false;
+        }
+    }
+
+    if (success) {
+        cout << (SOLVER_STATS_ENABLED ? "[OK] Solvers are silent and fill stats / trace samples"
+                                      : "[OK] Solvers are silent (stats disabled in this build)") << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test IncrementalSolver against a fresh bfsPath after every edit: random
+ * walls added and removed, doors opened, and the start walking along the path.
+ */
+bool testIncrementalSolver() {
+    cout << "=== Incremental Solver Test ===" << endl;
+
+    bool success = true;
+    mt19937 rng(21);
+    Grid dungeon = generateDungeonGrid(41, 61, 20, 21);
+    IncrementalSolver solver(dungeon);
+
+    auto check = [&](const string& what) {
+        vector<Cell> expected = bfsPath(dungeon);
+        vector<Cell> path = solver.path();
+        int distance = solver.distance();
+        bool valid = path.empty() || (path.front() == dungeon.start && path.back() == dungeon.exit &&
+                                      validatePath(dungeon.toStrings(), path));
+        if (path.size() != expected.size() || distance != static_cast<int>(expected.size()) - 1 || !valid) {
+            cout << "[ERROR] " << what << ": incremental length " << path.size()
+                 << ", distance " << distance << ", bfsPath length " << expected.size() << endl;
+            success = false;
+        }
+    };
+
+    check("initial solve");
+    for (int edit = 0; edit < 300 && success; edit++) {
+        int r = 1 + rng() % (dungeon.rows - 2), c = 1 + rng() % (dungeon.cols - 2);
+        char& cell = dungeon.at(r, c);
+        if (cell == 'S' || cell == 'E') continue;
+        cell = edit % 3 == 0 ? 'A' : (cell == '#' ? ' ' : '#');
+        solver.cellChanged(Cell(r, c));
+        if (edit % 3 == 1) check("edit " + to_string(edit));
+    }
+
+    // Open every door again, then block and reopen a cell on the current path
+    for (char& cell : dungeon.cells) {
+        if (cell == 'A') cell = ' ';
+    }
+    for (int idx = 0; idx < dungeon.size(); idx++) solver.cellChanged(dungeon.cellAt(idx));
+    check("doors opened");
+
+    vector<Cell> current = bfsPath(dungeon);
+    if (success && current.size() > 2) {
+        Cell middle = current[current.size() / 2];
+        dungeon.at(middle.r, middle.c) = '#';
+        solver.cellChanged(middle);
+        check("path blocked");
+        dungeon.at(middle.r, middle.c) = ' ';
+        solver.cellChanged(middle);
+        check("path reopened");
+    }
+
+    // Walk the start along the path; grid.start follows so bfsPath agrees
+    for (int step = 1; step < 6 && success; step++) {
+        current = solver.path();
+        if (current.size() < 3) break;
+        dungeon.at(dungeon.start.r, dungeon.start.c) = ' ';
+        dungeon.start = current[2];
+        dungeon.at(dungeon.start.r, dungeon.start.c) = 'S';
+        solver.moveStart(dungeon.start);
+        check("start moved " + to_string(step));
+    }
+
+    if (success) {
+        cout << "[OK] Incremental repairs match bfsPath (" << solver.expanded() << " cells expanded in total)" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test the multi-source distance field: single-source distances match
+ * bfsPath, the tiled version matches the sequential one exactly, and
+ * following nextStep reaches the reported source in dist steps.
+ */
+bool testDistanceField() {
+    cout << "=== Distance Field Test ===" << endl;
+
+    bool success = true;
+    Grid dungeon = generateDungeonGrid(97, 131, 20, 22);
+    ThreadPool pool(4);
+
+    DistanceField fromStart = multiSourceDistances(dungeon, {dungeon.start});
+    uint32_t expected = static_cast<uint32_t>(bfsPath(dungeon).size() - 1);
+    if (fromStart.distanceAt(dungeon.exit) != expected) {
+        cout << "[ERROR] Single-source distance " << fromStart.distanceAt(dungeon.exit)
+             << ", bfsPath " << expected << endl;
+        success = false;
+    }
+
+    // Several sources, one of them a wall and one a duplicate
+    mt19937 rng(22);
+    vector<Cell> sources = {dungeon.exit, Cell(0, 0)};
+    while (sources.size() < 12) {
+        Cell cell(rng() % dungeon.rows, rng() % dungeon.cols);
+        if (dungeon.at(cell.r, cell.c) == ' ') sources.push_back(cell);
+    }
+    sources.push_back(sources[5]);
+
+    DistanceField field = multiSourceDistances(dungeon, sources);
+    for (int tileSize : {7, 32, 256}) {
+        DistanceField tiled = multiSourceDistances(dungeon, sources, pool, tileSize);
+        if (tiled.dist != field.dist || tiled.source != field.source) {
+            cout << "[ERROR] Tiled field (tile " << tileSize << ") differs from sequential" << endl;
+            success = false;
+        }
+    }
+    if (field.sourceAt(sources.back()) != 5 || field.distanceAt(Cell(0, 0)) != DistanceField::UNREACHED) {
+        cout << "[ERROR] Duplicate or blocked source handled wrongly" << endl;
+        success = false;
+    }
+
+    for (int walk = 0; walk < 200 && success; walk++) {
+        Cell cell(rng() % dungeon.rows, rng() % dungeon.cols);
+        uint32_t steps = field.distanceAt(cell);
+        if (steps == DistanceField::UNREACHED) continue;
+        uint32_t id = field.sourceAt(cell);
+        for (uint32_t i = 0; i < steps; i++) cell = field.nextStep(cell);
+        if (!(cell == sources[id])) {
+            cout << "[ERROR] nextStep walk did not end at source " << id << endl;
+            success = false;
+        }
+    }
+
+    if (success) {
+        cout << "[OK] Sequential and tiled fields agree, nextStep walks reach their sources" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test the chunked layout and the hierarchical solver: cells survive the
+ * tiling, HPA* paths are valid and close to the BFS length, and unreachable
+ * or same-tile queries behave.
+ */
+bool testHierarchicalPathfinding() {
+    cout << "=== Hierarchical Pathfinding Test ===" << endl;
+
+    bool success = true;
+    ThreadPool pool(2);
+    for (int roomRate : {0, 20, 60}) {
+        Grid dungeon = generateDungeonGrid(151, 203, roomRate, 23 + roomRate);
+        ChunkedGrid chunked(dungeon, 16);
+        for (int r = 0; r < dungeon.rows && success; r++) {
+            for (int c = 0; c < dungeon.cols; c++) {
+                if (chunked.at(r, c) != dungeon.at(r, c)) {
+                    cout << "[ERROR] Chunked cell (" << r << "," << c << ") differs" << endl;
+                    success = false;
+                    break;
+                }
+            }
+        }
+
+        HierarchicalSolver solver(chunked, pool);
+        vector<Cell> path = solver.path();
+        size_t expected = bfsPath(dungeon).size();
+        if (!validatePath(dungeon.toStrings(), path) || path.size() < expected ||
+            path.size() > expected + expected / 4) {
+            cout << "[ERROR] roomRate " << roomRate << ": HPA* length " << path.size()
+                 << ", bfsPath " << expected << endl;
+            success = false;
+        }
+
+        // Endpoints inside one tile
+        Cell a = dungeon.start, b = dungeon.start;
+        for (int d = 1; d < 16 && b == a; d++) {
+            for (int i = 0; i < NUM_DIRECTIONS; i++) {
+                Cell next(a.r + DIRECTIONS[i][0] * d, a.c + DIRECTIONS[i][1] * d);
+                if (dungeon.inBounds(next.r, next.c) && dungeon.at(next.r, next.c) == ' ' &&
+                    chunked.tileOf(next.r, next.c) == chunked.tileOf(a.r, a.c)) {
+                    b = next;
+                    break;
+                }
+            }
+        }
+        vector<Cell> local = solver.path(a, b);
+        if (local.empty() || !(local.front() == a) || !(local.back() == b)) {
+            cout << "[ERROR] roomRate " << roomRate << ": same-tile query failed" << endl;
+            success = false;
+        }
+    }
+
+    // Walled-in exit
+    vector<string> blocked = {
+        "##########",
+        "#S       #",
+        "#     ####",
+        "#     #E #",
+        "#     ####",
+        "##########"
+    };
+    Grid walled(blocked);
+    ChunkedGrid chunkedWalled(walled, 4);
+    HierarchicalSolver walledSolver(chunkedWalled, pool);
+    if (!walledSolver.path().empty()) {
+        cout << "[ERROR] Found a path to a walled-in exit" << endl;
+        success = false;
+    }
+
+    if (success) {
+        cout << "[OK] HPA* paths are valid and within 25% of BFS" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test tiled parallel generation: without rooms the result is a perfect maze
+ * (connected, and exactly open - 1 adjacent open pairs), the output does not
+ * depend on the thread count, and roomed maps stay solvable.
+ */
+bool testTiledGeneration() {
+    cout << "=== Tiled Generation Test ===" << endl;
+
+    bool success = true;
+    ThreadPool single(1), several(3);
+    for (int tileCells : {1, 7, 64}) {
+        Grid dungeon = generateDungeonGridTiled(301, 257, 0, 24, several, tileCells);
+        size_t open = 0, pairs = 0;
+        for (int r = 0; r < dungeon.rows; r++) {
+            for (int c = 0; c < dungeon.cols; c++) {
+                if (dungeon.at(r, c) == '#') continue;
+                open++;
+                if (r + 1 < dungeon.rows && dungeon.at(r + 1, c) != '#') pairs++;
+                if (c + 1 < dungeon.cols && dungeon.at(r, c + 1) != '#') pairs++;
+            }
+        }
+        size_t reached = reachableFrom(BitGrid(dungeon), dungeon.start).count();
+        if (reached != open || pairs + 1 != open) {
+            cout << "[ERROR] tile " << tileCells << ": " << open << " open cells, " << reached
+                 << " reachable, " << pairs << " adjacent pairs (not a perfect maze)" << endl;
+            success = false;
+        }
+
+        Grid again = generateDungeonGridTiled(301, 257, 0, 24, single, tileCells);
+        if (again.cells != dungeon.cells) {
+            cout << "[ERROR] tile " << tileCells << ": output depends on the thread count" << endl;
+            success = false;
+        }
+    }
+
+    Grid roomed = generateDungeonGridTiled(201, 201, 20, 24, several, 16);
+    if (!validatePath(roomed.toStrings(), bfsPath(roomed))) {
+        cout << "[ERROR] Tiled dungeon with rooms is not solvable" << endl;
+        success = false;
+    }
+
+    if (success) {
+        cout << "[OK] Tiled mazes are perfect and independent of thread count" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test diameter placement (S and E mutually farthest in a perfect maze, and
+ * a path at least as long as scan placement) and boundedRandom's range and
+ * uniformity.
+ */
+bool testDiameterPlacement() {
+    cout << "=== Diameter Placement Test ===" << endl;
+
+    bool success = true;
+    for (int roomRate : {0, 20}) {
+        GeneratorContext scanCtx(25), diameterCtx(25, StartExitPlacement::Diameter);
+        Grid scan = generateDungeonGrid(151, 201, roomRate, scanCtx);
+        Grid diameter = generateDungeonGrid(151, 201, roomRate, diameterCtx);
+        size_t scanLength = bfsPath(scan).size(), diameterLength = bfsPath(diameter).size();
+        if (diameterLength == 0 || (roomRate == 0 && diameterLength < scanLength)) {
+            cout << "[ERROR] roomRate " << roomRate << ": diameter path " << diameterLength
+                 << ", scan path " << scanLength << endl;
+            success = false;
+        }
+
+        BitGrid map(diameter);
+        vector<uint32_t> fromStart = distanceField(map, diameter.start);
+        vector<uint32_t> fromExit = distanceField(map, diameter.exit);
+        uint32_t farthestFromStart = 0, farthestFromExit = 0;
+        for (size_t i = 0; i < fromStart.size(); i++) {
+            if (fromStart[i] != UINT32_MAX) farthestFromStart = max(farthestFromStart, fromStart[i]);
+            if (fromExit[i] != UINT32_MAX) farthestFromExit = max(farthestFromExit, fromExit[i]);
+        }
+        uint32_t length = static_cast<uint32_t>(diameterLength - 1);
+        if (roomRate == 0 && (farthestFromStart != length || farthestFromExit != length)) {
+            cout << "[ERROR] S and E are not mutually farthest (" << length << " vs "
+                 << farthestFromStart << " / " << farthestFromExit << ")" << endl;
+            success = false;
+        }
+        if (find(diameter.cells.begin(), diameter.cells.end(), '.') != diameter.cells.end()) {
+            cout << "[ERROR] Sweep marks left in the dungeon" << endl;
+            success = false;
+        }
+    }
+
+    Xoshiro256 rng(25);
+    int counts[3] = {0, 0, 0};
+    for (int i = 0; i < 30000; i++) counts[boundedRandom(rng, 3)]++;
+    for (int count : counts) {
+        if (count < 9500 || count > 10500) success = false;
+    }
+    if (boundedRandom(rng, 1) != 0 || counts[0] + counts[1] + counts[2] != 30000) success = false;
+    if (!success && counts[0] + counts[1] + counts[2] == 30000) {
+        cout << "[ERROR] boundedRandom(3) counts " << counts[0] << " " << counts[1] << " " << counts[2] << endl;
+    }
+
+    if (success) {
+        cout << "[OK] Diameter placement maximizes the S-E distance, boundedRandom is uniform" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that solvers, validation and the path printer give the same results
+ * on a GridView of a padded external buffer as on the Grid it was copied from.
+ */
+bool testGridView() {
+    cout << "=== Grid View Test ===" << endl;
+
+    bool success = true;
+    for (int i = 0; i < 6 && success; i++) {
+        Grid grid = generateDungeonGrid(31 + 10 * i, 45, 20 * (i % 3), 27 + i);
+
+        // Same dungeon in a buffer with 3 bytes of row padding
+        const int stride = grid.cols + 3;
+        vector<char> buffer(static_cast<size_t>(grid.rows) * stride, '?');
+        for (int r = 0; r < grid.rows; r++) {
+            copy(grid.cells.begin() + grid.index(r, 0), grid.cells.begin() + grid.index(r, grid.cols),
+                 buffer.begin() + static_cast<size_t>(r) * stride);
+        }
+        buffer.resize(buffer.size() - 3);  // The last row stops at cols, so nothing may read size() bytes
+        GridView view(buffer.data(), grid.rows, grid.cols, stride);
+
+        vector<Cell> expected = bfsPath(grid);
+        vector<Cell> viewPath = bfsPath(view);
+        if (view.start != grid.start || view.exit != grid.exit || viewPath != expected ||
+            bfsPathKeys(view) != bfsPathKeys(grid) || astarPath(view).size() != expected.size()) {
+            cout << "[ERROR] Solvers differ on the padded view of dungeon " << i << endl;
+            success = false;
+        }
+        if (!validatePath(view, viewPath) || !validatePath(grid.toStrings(), viewPath)) {
+            cout << "[ERROR] Valid path rejected on dungeon " << i << endl;
+            success = false;
+        }
+
+        // A diagonal step, a step into a wall and a path past the edge are all rejected
+        vector<Cell> bad = viewPath;
+        if (bad.size() > 2) bad.erase(bad.begin() + 1);
+        vector<Cell> offMap = {grid.start, Cell(-1, grid.start.c), grid.exit};
+        if (validatePath(view, bad) || validatePath(view, offMap) || validatePath(view, vector<Cell>())) {
+            cout << "[ERROR] Broken path accepted on dungeon " << i << endl;
+            success = false;
+        }
+
+        // Overlay written straight from the view, through a buffer smaller than a row
+        ostringstream fromView, fromStrings, small;
+        DungeonWriter(fromView).writeWithPath(view, viewPath, "Path");
+        DungeonWriter(fromStrings).writeWithPath(grid.toStrings(), viewPath, "Path");
+        DungeonWriter(small, 7).writeWithPath(view, viewPath, "Path");
+        Grid marked = grid;
+        for (const Cell& cell : viewPath) {
+            if (marked.at(cell.r, cell.c) != 'S' && marked.at(cell.r, cell.c) != 'E') marked.at(cell.r, cell.c) = '*';
+        }
+        ostringstream reference;
+        DungeonWriter(reference).write(marked, "Path");
+        if (fromView.str() != reference.str() || fromStrings.str() != reference.str() ||
+            small.str() != reference.str()) {
+            cout << "[ERROR] Path overlay from the view differs on dungeon " << i << endl;
+            success = false;
+        }
+    }
+
+    if (success) {
+        cout << "[OK] Padded grid views solve, validate and print like the owning Grid" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Shared test corpus: the hand-made layouts, then count seeded generated
+ * maps cycling through four sizes and room rates 0 / 20 / 40, with 1-5
+ * key-door pairs on every map whose S-E path is long enough. The same seed
+ * always gives the same corpus, so failures can be reproduced.
+ */
+vector<vector<string>> buildKeyDoorCorpus(int count, uint64_t seed) {
+    vector<vector<string>> dungeons = {createTestDungeon1(), createTestDungeon2(), createTestDungeonKeys(),
+                                       createUnsolvableDungeon()};
+    for (int i = 0; i < count; i++) {
+        int rows = 21 + 10 * (i % 4);
+        Grid grid = generateDungeonGrid(rows, rows + 20, (i % 3) * 20, seed + i);
+        addKeysAndDoors(grid, 1 + i % 5, seed + i);
+        dungeons.push_back(grid.toStrings());
+    }
+    return dungeons;
+}
+
+/**
+ * Test that the two-level POI-graph solver finds key-door paths exactly as
+ * short as bfsPathKeys, on the hand-made key dungeon and generated key maps.
+ * The corpus must include well-formed five-door maps (one 'E', doors A-D and
+ * F), the largest key count the generator places.
+ */
+bool testCompressedKeyPathfinding() {
+    cout << "=== Compressed Key Graph Test ===" << endl;
+
+    vector<vector<string>> dungeons = buildKeyDoorCorpus(60, 77);
+
+    bool success = true;
+    int fiveDoorMaps = 0;
+    for (size_t i = 0; i < dungeons.size() && success; i++) {
+        int exits = 0, doors = 0;
+        for (const string& row : dungeons[i]) {
+            for (char cell : row) {
+                exits += cell == 'E';
+                doors += (cellClass(cell) & CELL_DOOR) != 0;
+            }
+        }
+        if (exits > 1) {
+            cout << "[ERROR] Dungeon " << i << " has " << exits << " exits" << endl;
+            success = false;
+            break;
+        }
+        fiveDoorMaps += doors == 5;
+
+        Grid grid(dungeons[i]);
+        vector<Cell> expected = bfsPathKeys(grid);
+        vector<Cell> path = bfsPathKeysCompressed(grid);
+        if (path.size() != expected.size() || (!path.empty() && !validatePath(dungeons[i], path))) {
+            cout << "[ERROR] Compressed solver differs on dungeon " << i
+                 << " (" << path.size() << " vs " << expected.size() << ")" << endl;
+            printDungeonWithPath(dungeons[i], path, "Compressed Path");
+            success = false;
+        }
+    }
+    if (success && fiveDoorMaps == 0) {
+        cout << "[ERROR] Corpus has no five-door maps" << endl;
+        success = false;
+    }
+    if (success) {
+        cout << "[OK] Compressed key solver matched bfsPathKeys on " << dungeons.size() << " dungeons ("
+             << fiveDoorMaps << " with five doors)" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that CompactPath solves decode to the same cells as the vector<Cell>
+ * solvers, and that the run-length form round-trips.
+ */
+bool testCompactPath() {
+    cout << "=== Compact Path Test ===" << endl;
+
+    vector<vector<string>> dungeons = buildKeyDoorCorpus(20, 26);
+
+    bool success = true;
+    SolverContext ctx;
+    for (size_t i = 0; i < dungeons.size() && success; i++) {
+        Grid grid(dungeons[i]);
+        vector<Cell> expected = bfsPath(grid, ctx);
+        CompactPath compact = bfsPathCompact(grid, ctx);
+        vector<Cell> expectedKeys = bfsPathKeys(grid, ctx);
+        CompactPath compactKeys = bfsPathKeysCompact(grid, ctx);
+
+        vector<Cell> iterated(compact.begin(), compact.end());
+        if (iterated != expected || compact.toCells() != expected || compactKeys.toCells() != expectedKeys) {
+            cout << "[ERROR] Compact path differs on dungeon " << i << " (" << compact.size() << " vs "
+                 << expected.size() << ", keys " << compactKeys.size() << " vs " << expectedKeys.size() << ")"
+                 << endl;
+            success = false;
+            continue;
+        }
+        if (CompactPath::fromCells(expected).toCells() != expected ||
+            CompactPath::fromRuns(compactKeys.start(), compactKeys.runs()).toCells() != expectedKeys) {
+            cout << "[ERROR] fromCells / runs round trip failed on dungeon " << i << endl;
+            success = false;
+        }
+        if (!compact.empty() && compact.bytes() != (compact.steps() + 3) / 4) {
+            cout << "[ERROR] " << compact.bytes() << " bytes for " << compact.steps() << " steps" << endl;
+            success = false;
+        }
+    }
+
+    // A straight corridor is a single run
+    CompactPath corridor = CompactPath::fromCells({Cell(1, 1), Cell(1, 2), Cell(1, 3), Cell(1, 4)});
+    vector<uint32_t> runs = corridor.runs();
+    if (runs.size() != 1 || runs[0] != ((3u << 2) | 3u) ||
+        !CompactPath::fromCells({Cell(1, 1), Cell(2, 2)}).empty()) {
+        cout << "[ERROR] Corridor run encoding" << endl;
+        success = false;
+    }
+
+    if (success) {
+        cout << "[OK] Compact paths matched bfsPath / bfsPathKeys on " << dungeons.size() << " dungeons" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that SolveService futures resolve to the synchronous solvers' paths
+ * for requests of mixed sizes and modes submitted from several threads, and
+ * that requests still queued at destruction are solved.
+ */
+bool testSolveService() {
+    cout << "=== Solve Service Test ===" << endl;
+
+    vector<Grid> dungeons;
+    vector<SolveMode> modes;
+    for (const vector<string>& dungeon : buildKeyDoorCorpus(96, 28)) {
+        modes.push_back(dungeons.size() % 2 == 1 ? SolveMode::Keys : SolveMode::Basic);
+        dungeons.push_back(Grid(dungeon));
+    }
+
+    bool success = true;
+    ThreadPool pool(3);
+    vector<future<vector<Cell>>> results(dungeons.size());
+    size_t batches = 0;
+    {
+        SolveService service(pool, 16, chrono::microseconds(500));
+        vector<thread> clients;
+        for (int t = 0; t < 4; t++) {
+            clients.emplace_back([&, t] {
+                for (size_t i = t; i < dungeons.size(); i += 4) results[i] = service.submit(dungeons[i], modes[i]);
+            });
+        }
+        for (thread& client : clients) client.join();
+
+        for (size_t i = 0; i < dungeons.size() && success; i++) {
+            vector<Cell> expected = modes[i] == SolveMode::Keys ? bfsPathKeys(dungeons[i]) : bfsPath(dungeons[i]);
+            if (results[i].get() != expected) {
+                cout << "[ERROR] Service path differs on request " << i << endl;
+                success = false;
+            }
+        }
+        batches = service.batchesDispatched();
+        if (service.requestsDispatched() != dungeons.size() || batches < dungeons.size() / 16) {
+            cout << "[ERROR] " << service.requestsDispatched() << " requests in " << batches << " batches" << endl;
+            success = false;
+        }
+    }
+
+    // Long delay: the destructor must flush the pending partial batch
+    future<vector<Cell>> last;
+    {
+        SolveService service(pool, 1000, chrono::seconds(60));
+        last = service.submit(dungeons[0]);
+    }
+    if (last.wait_for(chrono::seconds(0)) != future_status::ready || last.get() != bfsPath(dungeons[0])) {
+        cout << "[ERROR] Queued request not solved at shutdown" << endl;
+        success = false;
+    }
+
+    if (success) {
+        cout << "[OK] " << dungeons.size() << " async solves matched in " << batches << " batches" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test gridHash, SolutionCache hits and LRU eviction, sharing between
+ * threads, and the cache behind SolveService.
+ */
+bool testSolutionCache() {
+    cout << "=== Solution Cache Test ===" << endl;
+
+    bool success = true;
+    Grid base = generateDungeonGrid(41, 53, 20, 29);
+
+    // Same contents behind a padded stride hash the same; one edited cell does not
+    const int stride = base.cols + 5;
+    vector<char> padded(static_cast<size_t>(base.rows) * stride, 'x');
+    for (int r = 0; r < base.rows; r++) {
+        copy(base.cells.begin() + base.index(r, 0), base.cells.begin() + base.index(r, base.cols),
+             padded.begin() + static_cast<size_t>(r) * stride);
+    }
+    Grid edited = base;
+    edited.at(base.rows / 2, base.cols / 2) ^= 1;
+    if (gridHash(GridView(padded.data(), base.rows, base.cols, stride)) != gridHash(base) ||
+        gridHash(edited) == gridHash(base) || gridHash(Grid(3, 5)) == gridHash(Grid(5, 3))) {
+        cout << "[ERROR] gridHash ignores contents or depends on padding" << endl;
+        success = false;
+    }
+
+    vector<Grid> dungeons = {Grid(createTestDungeon1()), Grid(createTestDungeonKeys()),
+                             Grid(createUnsolvableDungeon()), base};
+    SolutionCache cache(64, 4);
+    SolverContext ctx;
+    for (int pass = 0; pass < 2; pass++) {
+        for (const Grid& dungeon : dungeons) {
+            for (SolveMode mode : {SolveMode::Basic, SolveMode::Keys}) {
+                vector<Cell> expected = mode == SolveMode::Keys ? bfsPathKeys(dungeon) : bfsPath(dungeon);
+                if (cache.solve(dungeon, mode, ctx).toCells() != expected) {
+                    cout << "[ERROR] Cached path differs (pass " << pass << ")" << endl;
+                    success = false;
+                }
+            }
+        }
+    }
+    if (cache.misses() != 8 || cache.hits() != 8 || cache.size() != 8) {
+        cout << "[ERROR] " << cache.hits() << " hits, " << cache.misses() << " misses, " << cache.size()
+             << " entries" << endl;
+        success = false;
+    }
+
+    // Least recently used entry goes first
+    SolutionCache small(2, 1);
+    CompactPath path;
+    const Grid& a = dungeons[0];
+    const Grid& b = dungeons[1];
+    const Grid& c = dungeons[3];
+    small.insert(gridHash(a), a, SolveMode::Basic, CompactPath(a.start, 0));
+    small.insert(gridHash(b), b, SolveMode::Basic, CompactPath(b.start, 0));
+    small.find(gridHash(a), a, SolveMode::Basic, path);
+    small.insert(gridHash(c), c, SolveMode::Basic, CompactPath(c.start, 0));
+    if (!small.find(gridHash(a), a, SolveMode::Basic, path) || small.find(gridHash(b), b, SolveMode::Basic, path) ||
+        !small.find(gridHash(c), c, SolveMode::Basic, path) || small.find(gridHash(c), c, SolveMode::Keys, path)) {
+        cout << "[ERROR] LRU eviction order" << endl;
+        success = false;
+    }
+
+    // Shared between threads and behind the solve service
+    SolutionCache shared(16);
+    vector<vector<Cell>> expected;
+    for (const Grid& dungeon : dungeons) expected.push_back(bfsPathKeys(dungeon));
+    atomic<int> wrong(0);
+    vector<thread> workers;
+    for (int t = 0; t < 4; t++) {
+        workers.emplace_back([&] {
+            SolverContext local;
+            for (int i = 0; i < 200; i++) {
+                size_t d = i % dungeons.size();
+                if (shared.solve(dungeons[d], SolveMode::Keys, local).toCells() != expected[d]) wrong++;
+            }
+        });
+    }
+    for (thread& worker : workers) worker.join();
+
+    ThreadPool pool(2);
+    vector<future<vector<Cell>>> results;
+    {
+        SolveService service(pool, 8, chrono::microseconds(200), &shared);
+        for (int i = 0; i < 32; i++) results.push_back(service.submit(dungeons[i % dungeons.size()], SolveMode::Keys));
+    }
+    for (size_t i = 0; i < results.size(); i++) {
+        if (results[i].get() != expected[i % dungeons.size()]) wrong++;
+    }
+    if (wrong > 0 || shared.size() != dungeons.size() || shared.hits() < 800) {
+        cout << "[ERROR] Shared cache: " << wrong << " wrong paths, " << shared.size() << " entries, "
+             << shared.hits() << " hits" << endl;
+        success = false;
+    }
+
+    if (success) {
+        cout << "[OK] Cache hits match the solvers, LRU eviction and sharing behave" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test the early-exit reachability queries and ConnectivityLabels against
+ * bfsPath / bfsPathKeys, and countReachableKeys on the key-door dungeon.
+ */
+bool testReachabilityQueries() {
+    cout << "=== Reachability Query Test ===" << endl;
+
+    vector<vector<string>> dungeons = buildKeyDoorCorpus(30, 30);
+
+    bool success = true;
+    SolverContext ctx;
+    mt19937 rng(30);
+    for (size_t i = 0; i < dungeons.size() && success; i++) {
+        Grid grid(dungeons[i]);
+        ConnectivityLabels labels(grid);
+        const bool basic = !bfsPath(grid, ctx).empty();
+        const bool keys = !bfsPathKeys(grid, ctx).empty();
+
+        // Keys behind doors, by repeated flood fills that open doors whose key is held
+        uint8_t held = 0;
+        vector<string> opened = dungeons[i];
+        for (;;) {
+            uint8_t next = reachableKeys(Grid(opened), false, ctx);
+            if (next == held) break;
+            held = next;
+            for (string& row : opened) {
+                for (char& cell : row) {
+                    if (cell >= 'A' && cell <= 'F' && cell != 'E' && (held >> (cell - 'A') & 1)) cell = ' ';
+                }
+            }
+        }
+
+        if (exitReachable(grid, ctx) != basic || labels.exitReachable() != basic ||
+            labels.exitReachableWithKeys() != keys ||
+            labels.reachableKeys() != reachableKeys(grid, false, ctx) || labels.collectableKeys() != held) {
+            cout << "[ERROR] Reachability answers differ on dungeon " << i << " (basic " << basic << ", keys "
+                 << keys << ")" << endl;
+            success = false;
+        }
+
+        // Random cell pairs agree with a BFS between them
+        for (int q = 0; q < 20 && success; q++) {
+            Cell a(rng() % grid.rows, rng() % grid.cols), b(rng() % grid.rows, rng() % grid.cols);
+            bool open = labels.label(a) != ConnectivityLabels::BLOCKED && labels.label(b) != ConnectivityLabels::BLOCKED;
+            if (open && labels.connected(a, b) != !bfsPath(grid, a, b, ctx).empty()) {
+                cout << "[ERROR] connected() differs for (" << a.r << "," << a.c << ") - (" << b.r << "," << b.c
+                     << ") on dungeon " << i << endl;
+                success = false;
+            }
+        }
+    }
+
+    // Both keys of the key-door test dungeon are reachable once doors are ignored
+    int keyCount = countReachableKeys(createTestDungeonKeys());
+    if (keyCount != 2 || countReachableKeys(createTestDungeon1()) != 0) {
+        cout << "[ERROR] countReachableKeys returned " << keyCount << endl;
+        success = false;
+    }
+
+    if (success) {
+        cout << "[OK] Early-exit queries and union-find labels matched BFS on " << dungeons.size() << " dungeons"
+             << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that DungeonIndex distances and paths between random open cells agree
+ * with a BFS, both on perfect mazes (tree fast path) and mazes with rooms
+ * (landmark search), and that the landmark search expands fewer cells.
+ */
+bool testDungeonIndex() {
+    cout << "=== Dungeon Index Test ===" << endl;
+
+    bool success = true;
+    mt19937 rng(2024);
+    SolverContext ctx;
+
+    for (int roomRate : {0, 20, 60}) {
+        Grid dungeon = generateDungeonGrid(101, 101, roomRate, 3 + roomRate);
+        DungeonIndex index(dungeon);
+        SolverContext indexCtx;
+        size_t bfsExplored = 0, indexExplored = 0;
+        if (index.isTree() != (roomRate == 0)) {
+            cout << "[ERROR] Index tree detection wrong for roomRate " << roomRate << endl;
+            success = false;
+        }
+
+        vector<Cell> open;
+        for (int r = 0; r < dungeon.rows; r++)
+            for (int c = 0; c < dungeon.cols; c++)
+                if (dungeon.at(r, c) != '#') open.push_back(Cell(r, c));
+
+        for (int query = 0; query < 200 && success; query++) {
+            Cell a = open[rng() % open.size()];
+            Cell b = open[rng() % open.size()];
+            int expected = static_cast<int>(bfsPath(dungeon, a, b, ctx).size()) - 1;
+            bfsExplored += ctx.explored;
+            vector<Cell> route = index.path(a, b, indexCtx);
+            indexExplored += indexCtx.explored;
+
+            bool adjacent = !route.empty() && route.front() == a && route.back() == b;
+            for (size_t i = 1; i < route.size() && adjacent; i++) {
+                adjacent = abs(route[i].r - route[i - 1].r) + abs(route[i].c - route[i - 1].c) == 1;
+            }
+            if (index.distance(a, b) != expected || !adjacent ||
+                static_cast<int>(route.size()) - 1 != expected) {
+                cout << "[ERROR] Index query (" << a.r << "," << a.c << ") -> (" << b.r << "," << b.c
+                     << ") gave " << index.distance(a, b) << ", BFS says " << expected << endl;
+                success = false;
+            }
+        }
+
+        if (roomRate > 0 && success && indexExplored >= bfsExplored) {
+            cout << "[ERROR] Landmark search expanded " << indexExplored << " cells, BFS " << bfsExplored
+                 << " (roomRate " << roomRate << ")" << endl;
+            success = false;
+        } else if (roomRate > 0) {
+            cout << "roomRate " << roomRate << ": landmark search expanded " << indexExplored
+                 << " cells over 200 queries, BFS " << bfsExplored << endl;
+        }
+
+        if (index.distance(Cell(0, 0), open[0]) != -1) {
+            cout << "[ERROR] Wall cell reported as reachable" << endl;
+            success = false;
+        }
+    }
+    if (success) {
+        cout << "[OK] Index distances and paths match BFS on perfect and room mazes" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that walking the generator's spanning tree gives the same path
+ * length as BFS on perfect mazes.
+ */
+bool testTreePathfinding() {
+    cout << "=== Spanning Tree Path Test ===" << endl;
+
+    bool success = true;
+    for (uint64_t seed = 1; seed <= 20 && success; seed++) {
+        MazeTree tree;
+        Grid dungeon = generateDungeonGrid(81, 121, 0, seed, tree);
+        vector<Cell> expected = bfsPath(dungeon);
+        vector<Cell> path = treePath(dungeon, tree);
+        if (path.size() != expected.size() || !validatePath(dungeon.toStrings(), path)) {
+            cout << "[ERROR] Tree path differs for seed " << seed
+                 << " (" << path.size() << " vs " << expected.size() << ")" << endl;
+            success = false;
+        }
+    }
+    if (success) {
+        cout << "[OK] Tree walk matched BFS on 20 perfect mazes" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Test that the bit-packed reachability set and distance field agree with
+ * bfsPath, across word boundaries and on maps with doors in the way.
+ */
+bool testBitGridReachability() {
+    cout << "=== Bit Grid Reachability Test ===" << endl;
+
+    bool success = true;
+    SolverContext ctx;
+    mt19937 rng(14);
+
+    vector<Grid> dungeons;
+    for (int roomRate : {0, 20, 60}) dungeons.push_back(generateDungeonGrid(63, 201, roomRate, 14 + roomRate));
+    dungeons.push_back(Grid(vector<string>{
+        "##########",
+        "#S...#...#",
+        "#....A...#",
+        "#....#..E#",
+        "##########"
+    }));
+
+    for (size_t i = 0; i < dungeons.size() && success; i++) {
+        const Grid& dungeon = dungeons[i];
+        BitGrid map(dungeon);
+        BitGrid reach = reachableFrom(map, dungeon.start);
+        vector<uint32_t> dist = distanceField(map, dungeon.start);
+
+        size_t finite = 0;
+        for (int r = 0; r < dungeon.rows; r++) {
+            for (int c = 0; c < dungeon.cols; c++) {
+                bool reached = dist[static_cast<size_t>(r) * dungeon.cols + c] != UINT32_MAX;
+                if (reached) finite++;
+                if (reached != reach.test(r, c)) {
+                    cout << "[ERROR] reachableFrom and distanceField disagree at (" << r << "," << c << ")" << endl;
+                    success = false;
+                }
+            }
+        }
+        if (finite != reach.count()) success = false;
+
+        vector<Cell> targets = {dungeon.exit};
+        for (int sample = 0; sample < 100; sample++) {
+            targets.push_back(Cell(rng() % dungeon.rows, rng() % dungeon.cols));
+        }
+        for (const Cell& target : targets) {
+            vector<Cell> route = bfsPath(dungeon, dungeon.start, target, ctx);
+            uint32_t expected = route.empty() ? UINT32_MAX : static_cast<uint32_t>(route.size() - 1);
+            uint32_t got = dist[static_cast<size_t>(target.r) * dungeon.cols + target.c];
+            if (got != expected) {
+                cout << "[ERROR] Distance to (" << target.r << "," << target.c << ") is " << got
+                     << ", BFS says " << expected << " (dungeon " << i << ")" << endl;
+                success = false;
+                break;
+            }
+        }
+    }
+    if (success) {
+        cout << "[OK] Bit-packed reachability and distances match BFS" << endl;
+    }
+
+    cout << "--------------------------------------------------" << endl << endl;
+    return success;
+}
+
+/**
+ * Times fn() and returns the elapsed wall time in milliseconds.
+ */
+template <typename Fn>
+double timeMs(Fn&& fn) {
+    auto begin = chrono::steady_clock::now();
+    fn();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - begin).count();
+}
+
+/**
+ * Regression benchmark: key-door solve time on generated key maps versus the
+ * plain bfsPath baseline on the same map before keys and doors were added.
+ * Run with: ./dungeon_pathfinder --bench
+ */
+void benchKeySolver() {
+    cout << "=== Key Solver Benchmark ===" << endl;
+    const int sizes[] = {101, 501, 1001};
+    const int numKeys = 3;
+
+    for (int size : sizes) {
+        vector<string> dungeon = generateDungeon(size, size, 20);
+        vector<Cell> basePath;
+        double baseMs = timeMs([&] { basePath = bfsPath(dungeon); });
+        Grid grid(dungeon);
+        if (addKeysAndDoors(grid, numKeys, 12345 + size) != numKeys) {
+            cout << size << "x" << size << ": generated map too small for keys, skipped" << endl;
+            continue;
+        }
+
+        dungeon = grid.toStrings();
+        vector<Cell> keyPath, compressedPath;
+        double keyMs = timeMs([&] { keyPath = bfsPathKeys(dungeon); });
+        KeyGraph graph;
+        double graphMs = timeMs([&] { graph = buildKeyGraph(grid); });
+        double compressedMs = timeMs([&] { compressedPath = bfsPathKeysCompressed(grid, graph); });
+
+        cout << size << "x" << size << " keys=" << numKeys
+             << " | bfsPath " << baseMs << " ms (len " << basePath.size() << ")"
+             << " | bfsPathKeys " << keyMs << " ms (len " << keyPath.size() << ", "
+             << (validatePath(dungeon, keyPath) ? "valid" : "INVALID") << ")"
+             << " | ratio " << keyMs / baseMs
+             << " | key graph build " << graphMs << " ms + solve " << compressedMs
+             << " ms (len " << compressedPath.size() << ")" << endl;
+    }
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+/**
+ * The original hashes, kept only so benchHashBuckets can show the difference.
+ */
+struct LegacyCellHash {
+    size_t operator()(const Cell& cell) const {
+        return static_cast<size_t>(cell.r) * 1000 + static_cast<size_t>(cell.c);
+    }
+};
+
+struct LegacyKeyStateHash {
+    size_t operator()(const KeyState& state) const {
+        return (static_cast<size_t>(state.keyMask) << 16) |
+               (static_cast<size_t>(state.row) << 8) |
+               static_cast<size_t>(state.col);
+    }
+};
+
+/**
+ * Prints bucket-load statistics for a set of keys as an unordered container
+ * with the same bucket count would see them: how many buckets are used, the
+ * longest chain, and the average number of entries scanned per lookup.
+ */
+template <typename Key, typename Hash, typename Each>
+void reportBucketLoad(const string& label, size_t keyCount, Each&& forEachKey) {
+    unordered_set<size_t> sizing;
+    sizing.rehash(keyCount);
+    size_t buckets = sizing.bucket_count();
+
+    vector<uint32_t> load(buckets, 0);
+    Hash hash;
+    forEachKey([&](const Key& key) { load[hash(key) % buckets]++; });
+
+    size_t used = 0, longest = 0;
+    double probes = 0;
+    for (uint32_t chain : load) {
+        if (chain == 0) continue;
+        used++;
+        longest = max<size_t>(longest, chain);
+        probes += 0.5 * chain * (chain + 1);  // each entry costs its position in the chain
+    }
+
+    cout << label << ": buckets used " << 100.0 * used / buckets << "%"
+         << ", longest chain " << longest
+         << ", avg probes/hit " << probes / keyCount << endl;
+}
+
+/**
+ * Micro-benchmark: bucket loads of CellHash and KeyStateHash on a 4096x4096
+ * grid, before (legacy arithmetic hashes) and after (packed key + mixHash64).
+ */
+void benchHashBuckets() {
+    cout << "=== Hash Bucket Load (4096x4096) ===" << endl;
+    const int size = 4096;
+
+    auto forEachCell = [&](auto&& visit) {
+        for (int r = 0; r < size; r++)
+            for (int c = 0; c < size; c++) visit(Cell(r, c));
+    };
+    reportBucketLoad<Cell, LegacyCellHash>("CellHash before", size_t(size) * size, forEachCell);
+    reportBucketLoad<Cell, CellHash>("CellHash after ", size_t(size) * size, forEachCell);
+
+    // Two key masks keep the state count (and this benchmark's memory) reasonable
+    auto forEachState = [&](auto&& visit) {
+        for (int mask = 0; mask < 2; mask++)
+            for (int r = 0; r < size; r++)
+                for (int c = 0; c < size; c++) visit(KeyState(r, c, mask));
+    };
+    reportBucketLoad<KeyState, LegacyKeyStateHash>("KeyStateHash before", size_t(size) * size * 2, forEachState);
+    reportBucketLoad<KeyState, KeyStateHash>("KeyStateHash after ", size_t(size) * size * 2, forEachState);
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+/**
+ * Explored-cell counts and timings of single-ended BFS, bidirectional BFS and
+ * A* as the dungeon opens up (higher roomRate).
+ */
+void benchBidirectional() {
+    cout << "=== BFS / Bidirectional / A* Benchmark (2001x2001) ===" << endl;
+    SolverContext ctx;
+
+    for (int roomRate : {0, 20, 60}) {
+        Grid dungeon = generateDungeonGrid(2001, 2001, roomRate, 5);
+
+        vector<Cell> single, both;
+        double singleMs = timeMs([&] { single = bfsPath(dungeon, ctx); });
+        size_t singleExplored = ctx.explored;
+        double bothMs = timeMs([&] { both = bfsPathBidirectional(dungeon, ctx); });
+        size_t bothExplored = ctx.explored;
+        vector<Cell> astar;
+        double astarMs = timeMs([&] { astar = astarPath(dungeon, ctx); });
+        size_t astarExplored = ctx.explored;
+
+        cout << "roomRate " << roomRate
+             << " | bfsPath " << singleExplored << " cells, " << singleMs << " ms"
+             << " | bidirectional " << bothExplored << " cells, " << bothMs << " ms"
+             << " | A* " << astarExplored << " cells, " << astarMs << " ms"
+             << " | path " << single.size()
+             << (single.size() == both.size() && single.size() == astar.size() ? "" : " MISMATCH")
+             << endl;
+    }
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+/**
+ * Bit-packed reachability and distance field versus a full bfsPath flood
+ * (start to an unreachable target, so every reachable cell is expanded).
+ */
+void benchBitGrid() {
+    cout << "=== Bit Grid Benchmark (2001x2001) ===" << endl;
+    SolverContext ctx;
+
+    for (int roomRate : {0, 20, 60}) {
+        Grid dungeon = generateDungeonGrid(2001, 2001, roomRate, 5);
+        BitGrid map;
+        double packMs = timeMs([&] { map = BitGrid(dungeon); });
+
+        double floodMs = timeMs([&] { bfsPath(dungeon, dungeon.start, Cell(0, 0), ctx); });
+        size_t floodCells = ctx.explored;
+        BitGrid reach;
+        double reachMs = timeMs([&] { reach = reachableFrom(map, dungeon.start); });
+        vector<uint32_t> dist;
+        double distMs = timeMs([&] { dist = distanceField(map, dungeon.start); });
+
+        cout << "roomRate " << roomRate
+             << " | pack " << packMs << " ms"
+             << " | bfsPath flood " << floodCells << " cells, " << floodMs << " ms"
+             << " | reachableFrom " << reach.count() << " cells, " << reachMs << " ms"
+             << " | distanceField " << distMs << " ms"
+             << (reach.count() == floodCells ? "" : " MISMATCH") << endl;
+    }
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+/**
+ * Open and solve times for a binary corpus of 2001x2001 dungeons, against
+ * solving the in-memory Grids.
+ */
+void benchDungeonFile() {
+    cout << "=== Binary Dungeon File Benchmark (16 x 2001x2001) ===" << endl;
+    vector<Grid> dungeons;
+    generateDungeons(dungeons, 16, 2001, 2001, 20, 7);
+    const string path = "dungeon_bench.bin";
+    double writeMs = timeMs([&] { writeDungeonFile(path, dungeons); });
+
+    DungeonFile file;
+    double openMs = timeMs([&] { file.open(path); });
+    SolverContext ctx;
+    size_t mappedLength = 0, gridLength = 0;
+    double mappedMs = timeMs([&] {
+        for (size_t i = 0; i < file.size(); i++) mappedLength += bfsPath(file.dungeon(i), ctx).size();
+    });
+    double gridMs = timeMs([&] {
+        for (const Grid& dungeon : dungeons) gridLength += bfsPath(dungeon, ctx).size();
+    });
+
+    cout << "write " << writeMs << " ms | open " << openMs << " ms"
+         << " | solve from mapping " << mappedMs << " ms | solve Grids " << gridMs << " ms"
+         << (mappedLength == gridLength ? "" : " MISMATCH") << endl;
+    file.close();
+    remove(path.c_str());
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+/**
+ * Dumping a 4001x4001 dungeon to a file with per-row endl against
+ * DungeonWriter, and reading the file back with DungeonReader.
+ */
+void benchDungeonText() {
+    cout << "=== ASCII Dungeon Stream Benchmark (4001x4001) ===" << endl;
+    Grid dungeon = generateDungeonGrid(4001, 4001, 20, 9);
+    vector<string> rows = dungeon.toStrings();
+
+    const string path = "dungeon_bench.txt";
+    double legacyMs = timeMs([&] {
+        ofstream legacy(path);
+        for (const string& row : rows) legacy << row << endl;
+    });
+    double bufferedMs = timeMs([&] {
+        ofstream buffered(path);
+        DungeonWriter(buffered).write(dungeon);
+    });
+
+    Grid parsed;
+    double readMs = timeMs([&] {
+        ifstream in(path, ios::binary);
+        DungeonReader(in).next(parsed);
+    });
+    remove(path.c_str());
+
+    cout << "endl per row " << legacyMs << " ms | DungeonWriter " << bufferedMs << " ms"
+         << " | DungeonReader " << readMs << " ms"
+         << (parsed.cells == dungeon.cells ? "" : " MISMATCH") << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+/**
+ * High-QPS small-map queries: fresh SolverContext per solve (what the
+ * vector<string> API used to do) against one reused context.
+ */
+void benchSmallMapQueries() {
+    cout << "=== Small-Map Query Benchmark (20000 x 31x31) ===" << endl;
+    vector<Grid> dungeons;
+    generateDungeons(dungeons, 64, 31, 31, 20, 11);
+    vector<vector<string>> texts;
+    for (const Grid& dungeon : dungeons) texts.push_back(dungeon.toStrings());
+    const int queries = 20000;
+
+    size_t freshLength = 0, reusedLength = 0, textLength = 0;
+    double freshMs = timeMs([&] {
+        for (int i = 0; i < queries; i++) {
+            SolverContext ctx;
+            freshLength += bfsPath(dungeons[i % dungeons.size()], ctx).size();
+        }
+    });
+    SolverContext ctx;
+    double reusedMs = timeMs([&] {
+        for (int i = 0; i < queries; i++) reusedLength += bfsPath(dungeons[i % dungeons.size()], ctx).size();
+    });
+    double textMs = timeMs([&] {
+        for (int i = 0; i < queries; i++) textLength += bfsPath(texts[i % texts.size()], ctx).size();
+    });
+
+    cout << "fresh context " << freshMs << " ms | reused context " << reusedMs << " ms"
+         << " | vector<string> with context " << textMs << " ms"
+         << (freshLength == reusedLength && reusedLength == textLength ? "" : " MISMATCH") << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+void benchIncrementalSolver() {
+    cout << "=== Incremental Re-solve Benchmark (1023x1023, 200 edits) ===" << endl;
+    Grid dungeon = generateDungeonGrid(1023, 1023, 20, 21);
+    IncrementalSolver solver(dungeon);
+    double initialMs = timeMs([&] { solver.distance(); });
+    size_t initialExpanded = solver.expanded();
+
+    // Toggle random interior cells between wall and floor
+    mt19937 rng(21);
+    vector<Cell> edits;
+    for (int i = 0; i < 200; i++) {
+        Cell cell(1 + rng() % (dungeon.rows - 2), 1 + rng() % (dungeon.cols - 2));
+        char value = dungeon.at(cell.r, cell.c);
+        if (value != 'S' && value != 'E') edits.push_back(cell);
+    }
+
+    SolverContext ctx;
+    Grid scratch = dungeon;
+    size_t freshTotal = 0, incrementalTotal = 0;
+    double freshMs = timeMs([&] {
+        for (const Cell& cell : edits) {
+            char& value = scratch.at(cell.r, cell.c);
+            value = value == '#' ? ' ' : '#';
+            freshTotal += bfsPath(scratch, ctx).size();
+        }
+    });
+    double incrementalMs = timeMs([&] {
+        for (const Cell& cell : edits) {
+            char& value = dungeon.at(cell.r, cell.c);
+            value = value == '#' ? ' ' : '#';
+            solver.cellChanged(cell);
+            incrementalTotal += solver.distance() + 1;
+        }
+    });
+
+    cout << "initial solve " << initialMs << " ms (" << initialExpanded << " expanded) | "
+         << edits.size() << " edits: bfsPath from scratch " << freshMs << " ms, incremental "
+         << incrementalMs << " ms (" << solver.expanded() - initialExpanded << " expanded)"
+         << (freshTotal == incrementalTotal ? "" : " MISMATCH") << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+void benchDistanceField() {
+    cout << "=== Distance Field Benchmark (2047x2047, 64 sources) ===" << endl;
+    Grid dungeon = generateDungeonGrid(2047, 2047, 60, 22);
+    mt19937 rng(22);
+    vector<Cell> sources;
+    while (sources.size() < 64) {
+        Cell cell(rng() % dungeon.rows, rng() % dungeon.cols);
+        if (dungeon.at(cell.r, cell.c) == ' ') sources.push_back(cell);
+    }
+
+    SolverContext ctx;
+    size_t perSource = 0;
+    double perSourceMs = timeMs([&] {
+        for (int i = 0; i < 8; i++) perSource += bfsPath(dungeon, sources[i], dungeon.exit, ctx).size();
+    });
+    DistanceField sequential, tiled;
+    double sequentialMs = timeMs([&] { sequential = multiSourceDistances(dungeon, sources); });
+    double tiledMs = timeMs([&] { tiled = multiSourceDistances(dungeon, sources, ThreadPool::shared()); });
+
+    cout << "8 single-source bfsPath runs " << perSourceMs << " ms | one 64-source field "
+         << sequentialMs << " ms | tiled on " << ThreadPool::shared().size() << " workers " << tiledMs << " ms"
+         << (tiled.dist == sequential.dist && tiled.source == sequential.source ? "" : " MISMATCH") << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+void benchHierarchical() {
+    cout << "=== Hierarchical Pathfinding Benchmark (4095x4095, 64x64 tiles) ===" << endl;
+    Grid dungeon = generateDungeonGrid(4095, 4095, 20, 23);
+    ChunkedGrid chunked;
+    double layoutMs = timeMs([&] { chunked = ChunkedGrid(dungeon, 64); });
+    unique_ptr<HierarchicalSolver> solver;
+    double buildMs = timeMs([&] { solver = make_unique<HierarchicalSolver>(chunked); });
+
+    vector<Cell> flat, hierarchical;
+    SolverContext ctx;
+    double flatMs = timeMs([&] { flat = bfsPath(dungeon, ctx); });
+    double queryMs = timeMs([&] { hierarchical = solver->path(); });
+
+    cout << "layout " << layoutMs << " ms, abstract graph " << buildMs << " ms (" << solver->nodeCount()
+         << " nodes, " << solver->edgeCount() << " edges)" << endl;
+    cout << "bfsPath " << flatMs << " ms (length " << flat.size() << ", " << ctx.explored
+         << " cells expanded) | HPA* " << queryMs << " ms (length " << hierarchical.size() << ", "
+         << solver->tilesTouched() << "/" << chunked.tileCount() << " tiles touched)" << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+void benchTiledGeneration() {
+    const int size = 8191;
+    cout << "=== Tiled Generation Benchmark (" << size << "x" << size << ", roomRate 0) ===" << endl;
+    ThreadPool& pool = ThreadPool::shared();
+    Grid sequential, tiled;
+    double sequentialMs = timeMs([&] { sequential = generateDungeonGrid(size, size, 0, 24); });
+    double tiledMs = timeMs([&] { tiled = generateDungeonGridTiled(size, size, 0, 24, pool); });
+    cout << "generateDungeonGrid " << sequentialMs << " ms | tiled on " << pool.size() << " workers "
+         << tiledMs << " ms" << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+void benchPlacement() {
+    cout << "=== Start/Exit Placement Benchmark (256 x 255x255, roomRate 20) ===" << endl;
+    vector<Grid> dungeons;
+    ThreadPool single(1);
+    double scanMs = timeMs([&] { generateDungeons(dungeons, 256, 255, 255, 20, 25, single); });
+    size_t scanLength = 0;
+    for (const Grid& dungeon : dungeons) scanLength += bfsPath(dungeon).size();
+    double diameterMs = timeMs([&] {
+        generateDungeons(dungeons, 256, 255, 255, 20, 25, single, StartExitPlacement::Diameter);
+    });
+    size_t diameterLength = 0;
+    for (const Grid& dungeon : dungeons) diameterLength += bfsPath(dungeon).size();
+
+    cout << "scan " << scanMs << " ms (mean path " << scanLength / 256 << ") | diameter "
+         << diameterMs << " ms (mean path " << diameterLength / 256 << ")" << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+void benchCompactPath() {
+    cout << "=== Compact Path Benchmark (4095x4095, roomRate 20) ===" << endl;
+    Grid dungeon = generateDungeonGrid(4095, 4095, 20, 26);
+    SolverContext ctx;
+    vector<Cell> path;
+    CompactPath compact;
+    bfsPath(dungeon, ctx);  // Warm the scratch buffers
+    double vectorMs = timeMs([&] { path = bfsPath(dungeon, ctx); });
+    double compactMs = timeMs([&] { compact = bfsPathCompact(dungeon, ctx); });
+
+    cout << "vector<Cell> " << vectorMs << " ms, " << path.size() * sizeof(Cell) << " bytes | compact "
+         << compactMs << " ms, " << compact.bytes() << " bytes, " << compact.runs().size() << " runs ("
+         << path.size() << " cells)" << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+void benchPathOverlay() {
+    cout << "=== Path Overlay Benchmark (4095x4095, roomRate 20) ===" << endl;
+    Grid dungeon = generateDungeonGrid(4095, 4095, 20, 27);
+    vector<Cell> path = bfsPath(dungeon);
+    ostringstream copied, viewed;
+
+    // Previous approach: copy the whole map, mark it, write it
+    double copyMs = timeMs([&] {
+        Grid marked = dungeon;
+        for (const Cell& cell : path) {
+            char& current = marked.at(cell.r, cell.c);
+            if (current != 'S' && current != 'E') current = '*';
+        }
+        DungeonWriter(copied).write(marked);
+    });
+    double viewMs = timeMs([&] { DungeonWriter(viewed).writeWithPath(dungeon, path); });
+    bool valid = false;
+    double validateMs = timeMs([&] { valid = validatePath(dungeon, path); });
+
+    cout << "copy + write " << copyMs << " ms | view overlay " << viewMs << " ms"
+         << (copied.str() == viewed.str() ? "" : " (OUTPUT DIFFERS)") << " | validatePath " << validateMs
+         << " ms (" << path.size() << " cells, " << (valid ? "valid" : "INVALID") << ")" << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+void benchSolveService() {
+    cout << "=== Solve Service Benchmark (4096 requests, 63x63, roomRate 20) ===" << endl;
+    vector<Grid> dungeons;
+    generateDungeons(dungeons, 4096, 63, 63, 20, 28);
+
+    size_t syncLength = 0, asyncLength = 0;
+    double syncMs = timeMs([&] {
+        for (const Grid& dungeon : dungeons) syncLength += bfsPath(dungeon).size();
+    });
+    double asyncMs = timeMs([&] {
+        SolveService service;
+        vector<future<vector<Cell>>> results;
+        results.reserve(dungeons.size());
+        for (const Grid& dungeon : dungeons) results.push_back(service.submit(dungeon));
+        for (future<vector<Cell>>& result : results) asyncLength += result.get().size();
+    });
+
+    cout << "one at a time " << syncMs << " ms | service " << asyncMs << " ms ("
+         << ThreadPool::shared().size() << " workers" << (syncLength == asyncLength ? "" : ", PATHS DIFFER")
+         << ")" << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+void benchSolutionCache() {
+    cout << "=== Solution Cache Benchmark (2048 queries over 16 distinct 255x255 maps) ===" << endl;
+    vector<Grid> dungeons;
+    generateDungeons(dungeons, 16, 255, 255, 20, 29);
+
+    SolverContext ctx;
+    SolutionCache cache;
+    size_t plainLength = 0, cachedLength = 0;
+    double plainMs = timeMs([&] {
+        for (int i = 0; i < 2048; i++) plainLength += bfsPath(dungeons[i % 16], ctx).size();
+    });
+    double cachedMs = timeMs([&] {
+        for (int i = 0; i < 2048; i++) cachedLength += cache.solve(dungeons[i % 16], SolveMode::Basic, ctx).size();
+    });
+    double hashMs = timeMs([&] {
+        for (int i = 0; i < 2048; i++) gridHash(dungeons[i % 16]);
+    });
+
+    cout << "uncached " << plainMs << " ms | cached " << cachedMs << " ms (" << cache.hits() << " hits, "
+         << cache.misses() << " misses" << (plainLength == cachedLength ? "" : ", PATHS DIFFER")
+         << ") | hashing alone " << hashMs << " ms" << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+void benchReachability() {
+    cout << "=== Reachability Query Benchmark (4095x4095, roomRate 20) ===" << endl;
+    Grid dungeon = generateDungeonGrid(4095, 4095, 20, 30);
+    SolverContext ctx;
+    bfsPath(dungeon, ctx);  // Warm the scratch buffers
+
+    bool pathFound = false, reachable = false;
+    double pathMs = timeMs([&] { pathFound = !bfsPath(dungeon, ctx).empty(); });
+    double earlyMs = timeMs([&] { reachable = exitReachable(dungeon, ctx); });
+    unique_ptr<ConnectivityLabels> labels;
+    double labelMs = timeMs([&] { labels = make_unique<ConnectivityLabels>(dungeon); });
+
+    mt19937 rng(30);
+    vector<Cell> cells(1 << 20);
+    for (Cell& cell : cells) cell = Cell(rng() % dungeon.rows, rng() % dungeon.cols);
+    size_t connected = 0;
+    double queryMs = timeMs([&] {
+        for (size_t i = 0; i + 1 < cells.size(); i++) connected += labels->connected(cells[i], cells[i + 1]);
+    });
+
+    cout << "bfsPath " << pathMs << " ms | exitReachable " << earlyMs << " ms"
+         << (pathFound == reachable && reachable == labels->exitReachable() ? "" : " (ANSWERS DIFFER)")
+         << " | labeling " << labelMs << " ms (" << labels->regionCount() << " regions), then "
+         << queryMs * 1e6 / cells.size() << " ns per connected() query (" << connected << " connected)" << endl;
+    cout << "--------------------------------------------------" << endl << endl;
+}
+
+/**
+ * Generates one dungeon and solves it with the chosen algorithm:
+ *   ./dungeon_pathfinder --algo bfs|bidir|astar|keys|tree [rows cols roomRate seed]
+ * Prints the path length, expanded cells and solve time; small dungeons are
+ * also drawn with the path overlaid.
+ */
+int runSolveDriver(const string& algo, int rows, int cols, int roomRate, uint64_t seed) {
+    MazeTree tree;
+    Grid dungeon = algo == "tree" ? generateDungeonGrid(rows, cols, roomRate, seed, tree)
+                                  : generateDungeonGrid(rows, cols, roomRate, seed);
+    SolverContext ctx;
+    vector<Cell> path;
+
+    double ms;
+    if (algo == "bfs") ms = timeMs([&] { path = bfsPath(dungeon, ctx); });
+    else if (algo == "bidir") ms = timeMs([&] { path = bfsPathBidirectional(dungeon, ctx); });
+    else if (algo == "astar") ms = timeMs([&] { path = astarPath(dungeon, ctx); });
+    else if (algo == "keys") ms = timeMs([&] { path = bfsPathKeys(dungeon, ctx); });
+    else if (algo == "tree") ms = timeMs([&] { path = treePath(dungeon, tree); });
+    else {
+        cout << "Unknown algorithm '" << algo << "' (expected bfs, bidir, astar, keys or tree)" << endl;
+        return 1;
+    }
+
+    cout << algo << " on " << dungeon.rows << "x" << dungeon.cols << " (roomRate " << roomRate
+         << ", seed " << seed << "): path length " << path.size()
+         << ", expanded " << ctx.explored << ", " << ms << " ms" << endl;
+    if (SOLVER_STATS_ENABLED && (algo == "bfs" || algo == "keys")) {
+        cout << "  stats: peak queue " << ctx.stats.peakQueue << ", allocated " << ctx.stats.bytesAllocated
+             << " bytes, setup " << ctx.stats.setupMs << " ms, search " << ctx.stats.searchMs
+             << " ms, reconstruct " << ctx.stats.reconstructMs << " ms" << endl;
+    }
+    if (dungeon.cols <= 100 && dungeon.rows <= 100) {
+        printDungeonWithPath(dungeon, path, "Solution");
+    }
+    return path.empty() ? 1 : 0;
+}
+
+/**
+ * Main function that runs all test cases.
+ */
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        benchKeySolver();
+        benchHashBuckets();
+        benchBidirectional();
+        benchBitGrid();
+        benchDungeonFile();
+        benchDungeonText();
+        benchSmallMapQueries();
+        benchIncrementalSolver();
+        benchDistanceField();
+        benchHierarchical();
+        benchTiledGeneration();
+        benchPlacement();
+        benchCompactPath();
+        benchPathOverlay();
+        benchSolveService();
+        benchSolutionCache();
+        benchReachability();
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "--algo") == 0) {
+        int rows = argc > 3 ? atoi(argv[3]) : 21;
+        int cols = argc > 4 ? atoi(argv[4]) : 41;
+        int roomRate = argc > 5 ? atoi(argv[5]) : 20;
+        uint64_t seed = argc > 6 ? strtoull(argv[6], nullptr, 10) : 1;
+        return runSolveDriver(argv[2], rows, cols, roomRate, seed);
+    }
+
+    cout << "Testing Dungeon Pathfinder Algorithms" << endl;
+    cout << "================================================" << endl;
+    cout << "[TIP] If functions hang or fail, check for TODO messages!" << endl;
+    cout << "[TIP] Safety mechanisms will prevent infinite loops and provide guidance." << endl << endl;
+    
+    // Run all test cases and track progress
+    bool (*const tests[])() = {
+        testBasicPathfinding,
+        testComplexPathfinding,
+        testKeyDoorPathfinding,
+        testUnsolvableDungeon,
+        testDungeonGeneration,
+        testLargeDungeonGeneration,
+        testReproducibleGeneration,
+        testBatchGeneration,
+        testBatchSolving,
+        testBidirectionalPathfinding,
+        testAStarPathfinding,
+        testCompressedKeyPathfinding,
+        testDungeonIndex,
+        testTreePathfinding,
+        testBitGridReachability,
+        testDungeonFile,
+        testDungeonTextStream,
+        testSolverContextReuse,
+        testKeyCountSpecializations,
+        testSolverStats,
+        testIncrementalSolver,
+        testDistanceField,
+        testHierarchicalPathfinding,
+        testTiledGeneration,
+        testDiameterPlacement,
+        testCompactPath,
+        testGridView,
+        testSolveService,
+        testSolutionCache,
+        testReachabilityQueries,
+    };
+    int totalTests = sizeof(tests) / sizeof(tests[0]);
+    int passedTests = 0;
+
+    for (int i = 0; i < totalTests; i++) {
+        cout << "Running test " << (i + 1) << "/" << totalTests << "..." << endl;
+        if (tests[i]()) passedTests++;
+    }
+
+    // Display test progress summary
+    cout << "================================================" << endl;
+    cout << "TEST PROGRESS SUMMARY" << endl;
+    cout << "================================================" << endl;
+    cout << "Tests passed: " << passedTests << "/" << totalTests;
+    
+    if (passedTests == totalTests) {
+        cout << " [EXCELLENT! All tests passed!]" << endl;
+    } else if (passedTests >= totalTests * 0.8) {
+        cout << " [GREAT! Almost there!]" << endl;
+    } else if (passedTests >= totalTests * 0.5) {
+        cout << " [GOOD! Making progress!]" << endl;
+    } else if (passedTests > 0) {
+        cout << " [GETTING STARTED! Keep going!]" << endl;
+    } else {
+        cout << " [START HERE! Complete the TODOs above.]" << endl;
+    }
+    cout << endl;
+    cout << endl;
+    cout << "Implementation Requirements:" << endl;
+    cout << "================================================" << endl;
+    cout << "[REQUIRED] Complete the TODOs in generator.cpp for maze generation" << endl;
+    cout << "[REQUIRED] Complete the basic BFS in solver.cpp for pathfinding" << endl;
+    cout << "[REQUIRED] Complete the 3 TODOs in bfsPathKeys() for key-door mechanics" << endl;
     
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+/**
+ * Dungeon Pathfinder - Solution Cache
+ *
+ * Grid content hashing and the sharded LRU cache of compact solutions.
+ */
+
+#include "solution_cache.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+static const uint64_t HASH_PRIME = 0x9e3779b97f4a7c15ULL;
+
+/**
+ * Helper function: Fold one 8-byte word into the running hash
+ */
+static inline uint64_t hashWord(uint64_t h, uint64_t word) {
+    h ^= word;
+    h *= HASH_PRIME;
+    return (h << 31) | (h >> 33);
+}
+
+uint64_t gridHash(const GridView& grid) {
+    uint64_t h = mixHash64((static_cast<uint64_t>(static_cast<uint32_t>(grid.rows)) << 32) |
+                           static_cast<uint32_t>(grid.cols));
+    for (int r = 0; r < grid.rows; r++) {
+        const char* row = grid.row(r);
+        int c = 0;
+        for (; c + 8 <= grid.cols; c += 8) {
+            uint64_t word;
+            memcpy(&word, row + c, 8);
+            h = hashWord(h, word);
+        }
+
+        // Tail of the row, zero-padded to a word
+        if (c < grid.cols) {
+            uint64_t word = 0;
+            memcpy(&word, row + c, grid.cols - c);
+            h = hashWord(h, word);
+        }
+    }
+    return mixHash64(h);
+}
+
+SolutionCache::SolutionCache(size_t capacity, unsigned shards) {
+    const unsigned count = max(1u, shards);
+    shardCapacity = max<size_t>(1, (capacity + count - 1) / count);
+    for (unsigned i = 0; i < count; i++) this->shards.push_back(make_unique<Shard>());
+}
+
+SolutionCache::Key SolutionCache::makeKey(uint64_t hash, const GridView& grid, SolveMode mode) {
+    return Key{hash, grid.rows, grid.cols, mode};
+}
+
+bool SolutionCache::find(uint64_t hash, const GridView& grid, SolveMode mode, CompactPath& path) {
+    Shard& shard = shardFor(hash);
+    lock_guard<mutex> lock(shard.lock);
+    auto it = shard.index.find(makeKey(hash, grid, mode));
+    if (it == shard.index.end()) {
+        missCount.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    path = it->second->second;
+    hitCount.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+void SolutionCache::insert(uint64_t hash, const GridView& grid, SolveMode mode, const CompactPath& path) {
+    const Key key = makeKey(hash, grid, mode);
+    Shard& shard = shardFor(hash);
+    lock_guard<mutex> lock(shard.lock);
+
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        it->second->second = path;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    if (shard.lru.size() >= shardCapacity) {
+        shard.index.erase(shard.lru.back().first);
+        shard.lru.pop_back();
+    }
+    shard.lru.emplace_front(key, path);
+    shard.index.emplace(key, shard.lru.begin());
+}
+
+CompactPath SolutionCache::solve(const GridView& grid, SolveMode mode, SolverContext& ctx) {
+    const uint64_t hash = gridHash(grid);
+    CompactPath path;
+    if (find(hash, grid, mode, path)) return path;
+
+    // Solve outside any lock; two threads missing on the same dungeon both
+    // solve it and the second insert just refreshes the entry
+    path = mode == SolveMode::Keys ? bfsPathKeysCompact(grid, ctx) : bfsPathCompact(grid, ctx);
+    insert(hash, grid, mode, path);
+    return path;
+}
+
+size_t SolutionCache::size() const {
+    size_t total = 0;
+    for (const unique_ptr<Shard>& shard : shards) {
+        lock_guard<mutex> lock(shard->lock);
+        total += shard->lru.size();
+    }
+    return total;
+}
+
+void SolutionCache::clear() {
+    for (unique_ptr<Shard>& shard : shards) {
+        lock_guard<mutex> lock(shard->lock);
+        shard->index.clear();
+        shard->lru.clear();
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "cell.h"
+#include "grid.h"
+#include "compact_path.h"
+#include "solver.h"
+
+/**
+ * 64-bit hash of a dungeon's dimensions and cell contents (padding bytes
+ * past cols are ignored). Reads 8 cells per step, so hashing costs far less
+ * than a solve.
+ */
+uint64_t gridHash(const GridView& grid);
+
+/**
+ * Thread-safe LRU cache of solutions, keyed by gridHash plus the dungeon's
+ * dimensions and the solve mode. Paths are kept as CompactPath, and
+ * unsolvable dungeons are cached too, so a hit never runs a solver.
+ *
+ * The cache is split into shards picked by the hash, each with its own lock
+ * and LRU list, so threads working on different dungeons rarely contend.
+ * Capacity is divided evenly between the shards.
+ *
+ * Entries are matched on the hash, not on the full contents: two different
+ * dungeons of the same size colliding in 64 bits would share an entry.
+ */
+class SolutionCache {
+public:
+    /**
+     * @param capacity Total number of cached solutions
+     * @param shards Number of independently locked shards
+     */
+    explicit SolutionCache(size_t capacity = 4096, unsigned shards = 16);
+
+    SolutionCache(const SolutionCache&) = delete;
+    SolutionCache& operator=(const SolutionCache&) = delete;
+
+    /**
+     * Copies the cached solution into path and marks it most recently used.
+     * hash must be gridHash(grid).
+     *
+     * @return false if there is no entry
+     */
+    bool find(uint64_t hash, const GridView& grid, SolveMode mode, CompactPath& path);
+
+    /**
+     * Stores path for the dungeon, evicting the shard's least recently used
+     * entry when it is full. Replaces an existing entry for the same key.
+     */
+    void insert(uint64_t hash, const GridView& grid, SolveMode mode, const CompactPath& path);
+
+    /**
+     * bfsPathCompact / bfsPathKeysCompact through the cache: returns the
+     * cached path on a hit, otherwise solves with ctx and caches the result.
+     */
+    CompactPath solve(const GridView& grid, SolveMode mode, SolverContext& ctx);
+
+    size_t size() const;
+    size_t capacity() const { return shardCapacity * shards.size(); }
+    size_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+    size_t misses() const { return missCount.load(std::memory_order_relaxed); }
+
+    // Drops every entry; the hit and miss counters are kept
+    void clear();
+
+private:
+    struct Key {
+        uint64_t hash;
+        int rows;
+        int cols;
+        SolveMode mode;
+
+        bool operator==(const Key& other) const {
+            return hash == other.hash && rows == other.rows && cols == other.cols && mode == other.mode;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return static_cast<size_t>(mixHash64(key.hash ^ static_cast<uint64_t>(key.mode)));
+        }
+    };
+
+    // Front of lru is the most recently used entry
+    struct alignas(64) Shard {
+        std::mutex lock;
+        std::list<std::pair<Key, CompactPath>> lru;
+        std::unordered_map<Key, std::list<std::pair<Key, CompactPath>>::iterator, KeyHash> index;
+    };
+
+    static Key makeKey(uint64_t hash, const GridView& grid, SolveMode mode);
+    Shard& shardFor(uint64_t hash) { return *shards[(hash >> 32) % shards.size()]; }
+
+    size_t shardCapacity;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<size_t> hitCount{0};
+    std::atomic<size_t> missCount{0};
+};
@@ -0,0 +1,108 @@
+/**
+ * Dungeon Pathfinder - Solve Service
+ *
+ * Future-based request queue with size-ordered micro-batches on the thread pool.
+ */
+
+#include "solve_service.h"
+#include <algorithm>
+#include <exception>
+
+using namespace std;
+
+SolveService::SolveService(ThreadPool& pool, size_t maxBatch, chrono::microseconds maxDelay,
+                           SolutionCache* cache)
+    : pool(pool), maxBatch(max<size_t>(maxBatch, 1)), maxDelay(maxDelay), cache(cache), contexts(pool.size()) {
+    dispatcher = thread(&SolveService::dispatchLoop, this);
+}
+
+SolveService::~SolveService() {
+    {
+        lock_guard<mutex> lock(queueMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    dispatcher.join();
+}
+
+future<vector<Cell>> SolveService::submit(Grid grid, SolveMode mode) {
+    Request request{move(grid), mode, promise<vector<Cell>>(), chrono::steady_clock::now()};
+    future<vector<Cell>> result = request.result.get_future();
+    bool notify;
+    {
+        lock_guard<mutex> lock(queueMutex);
+        queue.push_back(move(request));
+
+        // The dispatcher only needs waking for the first request or a full batch
+        notify = queue.size() == 1 || queue.size() >= maxBatch;
+    }
+    if (notify) wake.notify_one();
+    return result;
+}
+
+size_t SolveService::batchesDispatched() const {
+    lock_guard<mutex> lock(queueMutex);
+    return batches;
+}
+
+size_t SolveService::requestsDispatched() const {
+    lock_guard<mutex> lock(queueMutex);
+    return dispatched;
+}
+
+/**
+ * Helper function: Waits for a batch to close, takes it off the queue and
+ * solves it without holding the lock, so submit() never blocks on a solve
+ */
+void SolveService::dispatchLoop() {
+    vector<Request> batch;
+    unique_lock<mutex> lock(queueMutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || !queue.empty(); });
+        if (queue.empty()) return;  // Stopping with nothing left
+
+        // Give the batch until the oldest request's deadline to fill up
+        const auto deadline = queue.front().queued + maxDelay;
+        wake.wait_until(lock, deadline, [&] { return stopping || queue.size() >= maxBatch; });
+
+        const size_t take = min(queue.size(), maxBatch);
+        batch.assign(make_move_iterator(queue.begin()), make_move_iterator(queue.begin() + take));
+        queue.erase(queue.begin(), queue.begin() + take);
+        batches++;
+        dispatched += take;
+
+        lock.unlock();
+        runBatch(batch);
+        batch.clear();
+        lock.lock();
+    }
+}
+
+/**
+ * Helper function: Solves one batch on the pool. Requests are ordered by grid
+ * size first, so the contiguous chunks each worker takes share a size.
+ */
+void SolveService::runBatch(vector<Request>& batch) {
+    vector<size_t> order(batch.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const Grid& x = batch[a].grid;
+        const Grid& y = batch[b].grid;
+        return x.size() != y.size() ? x.size() < y.size() : x.cols < y.cols;
+    });
+
+    pool.parallelFor(order.size(), [&](size_t index, unsigned worker) {
+        Request& request = batch[order[index]];
+        SolverContext& ctx = contexts[worker];
+        try {
+            if (cache) {
+                request.result.set_value(cache->solve(request.grid, request.mode, ctx).toCells());
+            } else {
+                request.result.set_value(request.mode == SolveMode::Keys ? bfsPathKeys(request.grid, ctx)
+                                                                         : bfsPath(request.grid, ctx));
+            }
+        } catch (...) {
+            request.result.set_exception(current_exception());
+        }
+    });
+}
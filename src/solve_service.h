@@ -0,0 +1,84 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "cell.h"
+#include "grid.h"
+#include "solver.h"
+#include "thread_pool.h"
+#include "solution_cache.h"
+
+/**
+ * Asynchronous front end over bfsPath / bfsPathKeys for request/response
+ * servers. submit() only queues the request and returns a future, so I/O
+ * threads never wait on a solve.
+ *
+ * A dispatcher thread collects requests into micro-batches. A batch closes
+ * when it holds maxBatch requests or when its oldest request has waited
+ * maxDelay. Each batch is ordered by grid size and solved with one
+ * parallelFor on the pool, so each worker's contiguous chunk is mostly
+ * same-sized dungeons that reuse the worker's SolverContext buffers. The
+ * contexts stay alive for the whole service, so steady-state solves do not
+ * allocate scratch memory.
+ *
+ * The destructor solves everything still queued before returning, so every
+ * future handed out becomes ready. Waiting on a future from inside a task on
+ * the same pool deadlocks, since the batch needs that pool to run.
+ */
+class SolveService {
+public:
+    /**
+     * @param pool Pool the batches run on; must outlive the service
+     * @param maxBatch Requests that close a batch at once
+     * @param maxDelay Longest a request waits for its batch to fill up
+     * @param cache Optional solution cache consulted before every solve;
+     *              must outlive the service and may be shared with others
+     */
+    explicit SolveService(ThreadPool& pool = ThreadPool::shared(), size_t maxBatch = 64,
+                          std::chrono::microseconds maxDelay = std::chrono::microseconds(200),
+                          SolutionCache* cache = nullptr);
+    ~SolveService();
+
+    SolveService(const SolveService&) = delete;
+    SolveService& operator=(const SolveService&) = delete;
+
+    /**
+     * Queues a solve of grid. Thread-safe. The future holds the path from S
+     * to E (empty if unsolvable), or the exception the solver threw.
+     */
+    std::future<std::vector<Cell>> submit(Grid grid, SolveMode mode = SolveMode::Basic);
+
+    // Batches taken off the queue so far, and the requests in them. A batch
+    // is counted before its futures become ready.
+    size_t batchesDispatched() const;
+    size_t requestsDispatched() const;
+
+private:
+    struct Request {
+        Grid grid;
+        SolveMode mode;
+        std::promise<std::vector<Cell>> result;
+        std::chrono::steady_clock::time_point queued;
+    };
+
+    void dispatchLoop();
+    void runBatch(std::vector<Request>& batch);
+
+    ThreadPool& pool;
+    const size_t maxBatch;
+    const std::chrono::microseconds maxDelay;
+    SolutionCache* cache;
+    std::vector<SolverContext> contexts;    // One per pool worker
+
+    mutable std::mutex queueMutex;
+    std::condition_variable wake;
+    std::vector<Request> queue;
+    size_t batches = 0;
+    size_t dispatched = 0;
+    bool stopping = false;
+    std::thread dispatcher;
+};
@@ -6,6 +6,7 @@
 
 #include "solver.h"
 #include "cell.h"
+#include "grid.h"
 #include <map>
 #include <set>
 #include <vector>
@@ -14,7 +15,8 @@
 #include <queue>
 #include <unordered_map>
 #include <unordered_set>
-#include <iostream>
+#include <cstdint>
+#include <cstdlib>
 
 using namespace std;
 
@@ -101,119 +103,528 @@ vector<Cell> reconstructPath(const unordered_map<Cell, Cell, CellHash>& parents,
     return path;
 }
 
-/**
- * Helper function: Check if a position is within bounds and not a wall
- * (used by key-door BFS which handles doors separately)
- */
-bool isValidPosition(const vector<string>& dungeon, int row, int col) {
-    if (row < 0 || row >= dungeon.size() || col < 0 || col >= dungeon[0].size()) {
-        return false;  // Out of bounds
-    }
-
-    // Only walls are impassable for key-door BFS (doors handled separately)
-    return dungeon[row][col] != '#';
-}
-
 /**
  * Helper function: Get all valid neighboring cells for basic BFS
+ * Writes them to neighbors (no allocation) and returns how many there are.
  */
-vector<Cell> getNeighbors(const vector<string>& dungeon, const Cell& current) {
-    vector<Cell> neighbors;
+int getNeighbors(const vector<string>& dungeon, const Cell& current, Cell (&neighbors)[NUM_DIRECTIONS]) {
+    int count = 0;
 
     for (int i = 0; i < NUM_DIRECTIONS; i++) {
         int newRow = current.r + DIRECTIONS[i][0];
         int newCol = current.c + DIRECTIONS[i][1];
 
         if (isPassable(dungeon, newRow, newCol)) {
-            neighbors.push_back(Cell(newRow, newCol));
+            neighbors[count++] = Cell(newRow, newCol);
         }
     }
 
-    return neighbors;
+    return count;
 }
 
-std::vector<Cell> bfsPath(const std::vector<std::string>& dungeon) {
+uint32_t SolverContext::beginSearch(size_t cells, uint32_t stamps) {
+    if (mark.size() < cells) mark.resize(cells, 0);
 
-    // STEP 1: Find start and exit positions (provided helper)
-    Cell start = findPosition(dungeon, 'S');
-    Cell exit = findPosition(dungeon, 'E');
+    // Stamps only ever grow; on wraparound every old stamp must read as unseen
+    if (nextStamp > UINT32_MAX - stamps) {
+        fill(mark.begin(), mark.end(), 0);
+        nextStamp = 1;
+    }
+    uint32_t base = nextStamp;
+    nextStamp += stamps;
+    return base;
+}
 
-    // Check if start and exit exist
-    if (start.r == -1 || exit.r == -1) {
-        return vector<Cell>();  // Invalid dungeon
+void SolverContext::reserve(size_t cells) {
+    if (frontier.size() < cells) frontier.resize(cells);
+    if (backFrontier.size() < cells) backFrontier.resize(cells);
+    if (parent.size() < cells) parent.resize(cells);
+    if (dist.size() < cells) dist.resize(cells);
+    if (mark.size() < cells) mark.resize(cells, 0);
+}
+
+/**
+ * Helper function: Reconstruct path from a flat parent array
+ * parent[i] holds the flat index of the cell we came from, -1 for the start.
+ */
+vector<Cell> reconstructFlatPath(const GridView& grid, const vector<int>& parent, int goal) {
+    vector<Cell> path;
+    for (int idx = goal; idx != -1; idx = parent[idx]) {
+        path.push_back(grid.cellAt(idx));
+    }
+
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+/**
+ * Helper function: Same as reconstructFlatPath when the goal's distance is
+ * known: the path is sized up front and filled from the back, so there is
+ * no push_back growth and no reverse.
+ */
+static vector<Cell> reconstructFlatPath(const GridView& grid, const vector<int>& parent, int goal, int distance) {
+    vector<Cell> path(static_cast<size_t>(distance) + 1);
+    int idx = goal;
+    for (int i = distance; i >= 0; i--, idx = parent[idx]) {
+        path[i] = grid.cellAt(idx);
     }
+    return path;
+}
 
-    // STEP 2: Initialize BFS data structures
-    queue<Cell> bfsQueue;
-    unordered_set<Cell, CellHash> visited;
-    unordered_map<Cell, Cell, CellHash> parents;
+/**
+ * Helper function: Direction code (DIRECTIONS order) of the step from flat
+ * index from to its neighbour to
+ */
+static inline uint8_t stepCode(int from, int to, int stride) {
+    const int delta = to - from;
+    return delta == -stride ? 0 : delta == stride ? 1 : delta == -1 ? 2 : 3;
+}
 
-    // STEP 3: Add start to queue and mark as visited
-    bfsQueue.push(start);
-    visited.insert(start);
+/**
+ * Helper function: Flat parent chain from goal back to start as a
+ * CompactPath, filling the direction codes from the back
+ */
+static CompactPath reconstructFlatCompact(const GridView& grid, const vector<int>& parent, int start, int goal,
+                                          int distance) {
+    CompactPath path(grid.cellAt(start), static_cast<size_t>(distance));
+    int idx = goal;
+    for (int i = distance - 1; i >= 0; i--) {
+        int previous = parent[idx];
+        path.setDirection(i, stepCode(previous, idx, grid.stride));
+        idx = previous;
+    }
+    return path;
+}
 
-    cout << "Starting BFS from (" << start.r << "," << start.c << ") to ("
-         << exit.r << "," << exit.c << ")" << endl;
+/**
+ * Helper function: Bytes currently reserved by the context's scratch buffers
+ */
+static size_t scratchBytes(const SolverContext& ctx) {
+    return ctx.frontier.capacity() * sizeof(int) + ctx.mark.capacity() * sizeof(uint32_t) +
+           ctx.parent.capacity() * sizeof(int) + ctx.keyVisited.capacity() * sizeof(uint64_t) +
+           ctx.keyParent.capacity() + ctx.keyFrontier32.capacity() * sizeof(uint32_t) +
+           ctx.keyFrontier64.capacity() * sizeof(uint64_t) + ctx.backFrontier.capacity() * sizeof(int) +
+           ctx.dist.capacity() * sizeof(int) + ctx.grid.cells.capacity();
+}
 
-    // STEP 4: Main BFS loop
-    while (!bfsQueue.empty())
-    {
-        Cell current = bfsQueue.front();
-        bfsQueue.pop();
+/**
+ * Helper function: Start-of-solve stats bookkeeping; returns the scratch size
+ * to diff against in finishStats. No-op unless ENABLE_SOLVER_STATS is defined.
+ */
+static inline size_t beginStats(SolverContext& ctx) {
+    if constexpr (SOLVER_STATS_ENABLED) {
+        ctx.stats.reset();
+        return scratchBytes(ctx);
+    }
+    return 0;
+}
 
-        if (current == exit)
-        {
-            return reconstructPath(parents, start, current);
+/**
+ * Helper function: Per-expansion stats and trace sampling.
+ * No-op unless ENABLE_SOLVER_STATS is defined.
+ */
+static inline void recordExpansion(SolverContext& ctx, const char* solver, size_t expanded,
+                                   size_t queued, int cell, uint32_t keyMask) {
+    if constexpr (SOLVER_STATS_ENABLED) {
+        ctx.stats.statesPerMask[keyMask]++;
+        if (queued > ctx.stats.peakQueue) ctx.stats.peakQueue = queued;
+        if (ctx.trace.hook && expanded % ctx.trace.interval == 0) {
+            ctx.trace.hook(TraceSample{solver, expanded, queued, cell, keyMask}, ctx.trace.user);
         }
+    }
+}
 
-        for (auto neighbor : getNeighbors(dungeon, current))
-        {
-            if ((isPassable(dungeon, neighbor.r, neighbor.c)) && (visited.count(neighbor) == 0))
-            {
-                bfsQueue.push(neighbor);
-                visited.insert(neighbor);
-                parents[neighbor] = current;
-            }
-        }
+/**
+ * Helper function: End-of-solve stats bookkeeping.
+ * No-op unless ENABLE_SOLVER_STATS is defined.
+ */
+static inline void finishStats(SolverContext& ctx, size_t scratchBefore, size_t pathBytes) {
+    if constexpr (SOLVER_STATS_ENABLED) {
+        size_t scratchAfter = scratchBytes(ctx);
+        ctx.stats.expanded = ctx.explored;
+        ctx.stats.bytesAllocated = (scratchAfter > scratchBefore ? scratchAfter - scratchBefore : 0) + pathBytes;
     }
-    // STEP 5: Return empty path if no solution found
-    return vector<Cell>();
 }
 
 /**
- * State structure for key-door BFS that includes position and collected keys.
- *
- * CONCEPT: In basic BFS, state = (row, col). In key-door BFS, state = (row, col, keys).
- * The same position with different keys represents different states with different possibilities.
- *
- * See BITMASK_BFS_GUIDE.md for detailed explanation of state augmentation concepts.
+ * Helper function: Flat BFS from startIdx until exitIdx is dequeued. Leaves
+ * the parent chain in ctx.parent and returns the exit's distance, or -1 if
+ * it is unreachable. The distance comes from tracking where each BFS level
+ * ends in the queue, so reconstruction can size its output up front.
  */
-struct KeyState {
-    int row, col;    // Position (same as basic BFS)
-    int keyMask;     // Bitmask representing which keys we have
+static int flatSearch(const GridView& grid, int startIdx, int exitIdx, SolverContext& ctx) {
+    const int stride = grid.stride;
+    const char* cells = grid.cells;
+
+    // Flat BFS state: every cell is enqueued at most once, so the queue is a
+    // plain array with a read cursor. Buffers come from the context and keep
+    // their capacity between solves; parent entries are only read for cells
+    // stamped in this search, so nothing needs clearing.
+    PhaseTimer setupTimer(ctx.stats.setupMs);
+    vector<int>& frontier = ctx.frontier;
+    vector<int>& parent = ctx.parent;
+    if (frontier.size() < static_cast<size_t>(grid.size())) frontier.resize(grid.size());
+    if (parent.size() < static_cast<size_t>(grid.size())) parent.resize(grid.size());
+    const uint32_t seen = ctx.beginSearch(grid.size());
+    uint32_t* mark = ctx.mark.data();
+    int head = 0, tail = 0;
+
+    frontier[tail++] = startIdx;
+    mark[startIdx] = seen;
+    parent[startIdx] = -1;
+    setupTimer.stop();
+
+    PhaseTimer searchTimer(ctx.stats.searchMs);
+    int depth = 0, levelEnd = tail;
+    while (head < tail) {
+        if (head == levelEnd) {
+            depth++;
+            levelEnd = tail;
+        }
+        int current = frontier[head++];
+        recordExpansion(ctx, "bfsPath", head, tail - head, current, 0);
+
+        if (current == exitIdx) {
+            ctx.explored = head;
+            return depth;
+        }
 
-    // Default constructor (needed for unordered_map)
-    KeyState() : row(0), col(0), keyMask(0) {}
+        int col = current % stride;
+        int neighbors[NUM_DIRECTIONS];
+        int count = 0;
+
+        // Same order as DIRECTIONS: up, down, left, right
+        if (current >= stride) neighbors[count++] = current - stride;
+        if (current + stride < grid.size()) neighbors[count++] = current + stride;
+        if (col > 0) neighbors[count++] = current - 1;
+        if (col + 1 < grid.cols) neighbors[count++] = current + 1;
+
+        for (int i = 0; i < count; i++) {
+            int next = neighbors[i];
+            if (mark[next] != seen && isOpenChar(cells[next])) {
+                mark[next] = seen;
+                parent[next] = current;
+                frontier[tail++] = next;
+            }
+        }
+    }
 
-    // Parameterized constructor
-    KeyState(int r, int c, int keys) : row(r), col(c), keyMask(keys) {}
+    ctx.explored = head;
+    return -1;
+}
 
-    bool operator==(const KeyState& other) const {
-        return row == other.row && col == other.col && keyMask == other.keyMask;
+std::vector<Cell> bfsPath(const GridView& grid, Cell from, Cell to, SolverContext& ctx) {
+    ctx.explored = 0;
+    const size_t scratchBefore = beginStats(ctx);
+    if (!grid.inBounds(from.r, from.c) || !grid.inBounds(to.r, to.c)) {
+        return vector<Cell>();  // Invalid endpoints
     }
-};
+
+    const int exitIdx = grid.index(to.r, to.c);
+    const int distance = flatSearch(grid, grid.index(from.r, from.c), exitIdx, ctx);
+
+    vector<Cell> path;
+    if (distance >= 0) {
+        PhaseTimer reconstructTimer(ctx.stats.reconstructMs);
+        path = reconstructFlatPath(grid, ctx.parent, exitIdx, distance);
+    }
+    finishStats(ctx, scratchBefore, path.capacity() * sizeof(Cell));
+    return path;
+}
+
+CompactPath bfsPathCompact(const GridView& grid, Cell from, Cell to, SolverContext& ctx) {
+    ctx.explored = 0;
+    const size_t scratchBefore = beginStats(ctx);
+    if (!grid.inBounds(from.r, from.c) || !grid.inBounds(to.r, to.c)) {
+        return CompactPath();
+    }
+
+    const int startIdx = grid.index(from.r, from.c);
+    const int exitIdx = grid.index(to.r, to.c);
+    const int distance = flatSearch(grid, startIdx, exitIdx, ctx);
+
+    CompactPath path;
+    if (distance >= 0) {
+        PhaseTimer reconstructTimer(ctx.stats.reconstructMs);
+        path = reconstructFlatCompact(grid, ctx.parent, startIdx, exitIdx, distance);
+    }
+    finishStats(ctx, scratchBefore, path.bytes());
+    return path;
+}
+
+CompactPath bfsPathCompact(const GridView& grid, SolverContext& ctx) {
+    if (grid.start.r == -1 || grid.exit.r == -1) {
+        ctx.explored = 0;
+        return CompactPath();
+    }
+    return bfsPathCompact(grid, grid.start, grid.exit, ctx);
+}
+
+std::vector<Cell> bfsPath(const GridView& grid, SolverContext& ctx) {
+    if (grid.start.r == -1 || grid.exit.r == -1) {
+        ctx.explored = 0;
+        return vector<Cell>();  // Invalid dungeon
+    }
+    return bfsPath(grid, grid.start, grid.exit, ctx);
+}
+
+std::vector<Cell> bfsPath(const GridView& grid) {
+    SolverContext ctx;
+    return bfsPath(grid, ctx);
+}
 
 /**
- * Hash function for KeyState to use in unordered containers.
+ * Helper function: Expand one complete BFS level for one side of the
+ * bidirectional search. Cells in [begin, end) of queue are the level; newly
+ * found cells are appended at end. Every edge into the other side's territory
+ * is a meeting candidate; the shortest one seen is kept in bestLength/bestA/bestB.
  */
-struct KeyStateHash {
-    size_t operator()(const KeyState& state) const {
-        // Combine position and key mask into a single hash
-        return (static_cast<size_t>(state.keyMask) << 16) |
-               (static_cast<size_t>(state.row) << 8) |
-               static_cast<size_t>(state.col);
+static int expandLevel(const GridView& grid, SolverContext& ctx, vector<int>& queue,
+                       int begin, int end, uint32_t side, uint32_t base,
+                       int& bestLength, int& bestA, int& bestB) {
+    const int stride = grid.stride;
+    const char* cells = grid.cells;
+    uint32_t* owner = ctx.mark.data();
+    vector<int>& parent = ctx.parent;
+    vector<int>& dist = ctx.dist;
+    int tail = end;
+
+    for (int i = begin; i < end; i++) {
+        int current = queue[i];
+        int col = current % stride;
+        int neighbors[NUM_DIRECTIONS];
+        int count = 0;
+
+        if (current >= stride) neighbors[count++] = current - stride;
+        if (current + stride < grid.size()) neighbors[count++] = current + stride;
+        if (col > 0) neighbors[count++] = current - 1;
+        if (col + 1 < grid.cols) neighbors[count++] = current + 1;
+
+        for (int n = 0; n < count; n++) {
+            int next = neighbors[n];
+            if (!isOpenChar(cells[next])) continue;
+
+            if (owner[next] < base) {
+                owner[next] = side;
+                parent[next] = current;
+                dist[next] = dist[current] + 1;
+                queue[tail++] = next;
+            } else if (owner[next] != side) {
+                int length = dist[current] + 1 + dist[next];
+                if (bestLength == -1 || length < bestLength) {
+                    bestLength = length;
+                    bestA = current;
+                    bestB = next;
+                }
+            }
+        }
     }
-};
+
+    return tail;
+}
+
+std::vector<Cell> bfsPathBidirectional(const GridView& grid, SolverContext& ctx) {
+    ctx.explored = 0;
+    if (grid.start.r == -1 || grid.exit.r == -1) {
+        return vector<Cell>();
+    }
+
+    const int startIdx = grid.index(grid.start.r, grid.start.c);
+    const int exitIdx = grid.index(grid.exit.r, grid.exit.c);
+
+    // mark doubles as the owner map: base = reached from S, base + 1 = reached
+    // from E. parent points back toward whichever endpoint the cell was reached from.
+    vector<int>& forward = ctx.frontier;
+    vector<int>& backward = ctx.backFrontier;
+    if (forward.size() < static_cast<size_t>(grid.size())) forward.resize(grid.size());
+    if (ctx.parent.size() < static_cast<size_t>(grid.size())) ctx.parent.resize(grid.size());
+    if (backward.size() < static_cast<size_t>(grid.size())) backward.resize(grid.size());
+    if (ctx.dist.size() < static_cast<size_t>(grid.size())) ctx.dist.resize(grid.size());
+    const uint32_t FROM_START = ctx.beginSearch(grid.size(), 2), FROM_EXIT = FROM_START + 1;
+    ctx.mark[startIdx] = FROM_START;
+    ctx.mark[exitIdx] = FROM_EXIT;
+    ctx.parent[startIdx] = ctx.parent[exitIdx] = -1;
+    ctx.dist[startIdx] = ctx.dist[exitIdx] = 0;
+
+    // Each side's queue holds its current level in [head, levelEnd)
+    int forwardHead = 0, forwardEnd = 0, backwardHead = 0, backwardEnd = 0;
+    forward[forwardEnd++] = startIdx;
+    backward[backwardEnd++] = exitIdx;
+
+    int bestLength = -1, bestA = -1, bestB = -1;
+    while (forwardHead < forwardEnd && backwardHead < backwardEnd) {
+        // Always grow the smaller frontier; finish the whole level before
+        // checking for a meeting so the best candidate is a shortest path
+        int newEnd;
+        if (forwardEnd - forwardHead <= backwardEnd - backwardHead) {
+            newEnd = expandLevel(grid, ctx, forward, forwardHead, forwardEnd, FROM_START, FROM_START,
+                                 bestLength, bestA, bestB);
+            ctx.explored += forwardEnd - forwardHead;
+            forwardHead = forwardEnd;
+            forwardEnd = newEnd;
+        } else {
+            newEnd = expandLevel(grid, ctx, backward, backwardHead, backwardEnd, FROM_EXIT, FROM_START,
+                                 bestLength, bestA, bestB);
+            ctx.explored += backwardEnd - backwardHead;
+            backwardHead = backwardEnd;
+            backwardEnd = newEnd;
+        }
+
+        if (bestLength != -1) break;
+    }
+
+    if (bestLength == -1) {
+        return vector<Cell>();
+    }
+
+    // bestA/bestB are adjacent cells owned by different sides
+    int startSide = ctx.mark[bestA] == FROM_START ? bestA : bestB;
+    int exitSide = startSide == bestA ? bestB : bestA;
+
+    vector<Cell> path = reconstructFlatPath(grid, ctx.parent, startSide);
+    for (int idx = exitSide; idx != -1; idx = ctx.parent[idx]) {
+        path.push_back(grid.cellAt(idx));
+    }
+    return path;
+}
+
+std::vector<Cell> bfsPathBidirectional(const GridView& grid) {
+    SolverContext ctx;
+    return bfsPathBidirectional(grid, ctx);
+}
+
+std::vector<Cell> astarPath(const GridView& grid, SolverContext& ctx) {
+    ctx.explored = 0;
+    if (grid.start.r == -1 || grid.exit.r == -1) {
+        return vector<Cell>();
+    }
+
+    const int startIdx = grid.index(grid.start.r, grid.start.c);
+    const int exitIdx = grid.index(grid.exit.r, grid.exit.c);
+    const int stride = grid.stride;
+    const char* cells = grid.cells;
+    const int exitRow = grid.exit.r, exitCol = grid.exit.c;
+
+    auto heuristic = [&](int idx) {
+        return abs(idx / stride - exitRow) + abs(idx % stride - exitCol);
+    };
+
+    // mark: below OPEN = unseen, OPEN = open, CLOSED = closed. dist holds g (steps from S).
+    vector<int>& parent = ctx.parent;
+    vector<int>& g = ctx.dist;
+    if (parent.size() < static_cast<size_t>(grid.size())) parent.resize(grid.size());
+    if (g.size() < static_cast<size_t>(grid.size())) g.resize(grid.size());
+    const uint32_t OPEN = ctx.beginSearch(grid.size(), 2), CLOSED = OPEN + 1;
+    uint32_t* state = ctx.mark.data();
+
+    // Bucketed open list. Every step costs 1 and Manhattan distance changes by
+    // exactly 1, so f = g + h either stays the same or grows by 2: two buckets
+    // (f and f + 2) are enough. Buckets are LIFO, which breaks ties toward the
+    // deepest node and keeps the search hugging the goal direction.
+    vector<int>& current = ctx.frontier;
+    vector<int>& next = ctx.backFrontier;
+    current.clear();
+    next.clear();
+
+    state[startIdx] = OPEN;
+    parent[startIdx] = -1;
+    g[startIdx] = 0;
+    int f = heuristic(startIdx);
+    current.push_back(startIdx);
+
+    while (!current.empty() || !next.empty()) {
+        if (current.empty()) {
+            swap(current, next);
+            f += 2;
+        }
+
+        int node = current.back();
+        current.pop_back();
+        if (state[node] == CLOSED) continue;  // Stale duplicate entry
+        if (g[node] + heuristic(node) != f) continue;  // Superseded by a shorter g
+
+        state[node] = CLOSED;
+        ctx.explored++;
+
+        if (node == exitIdx) {
+            return reconstructFlatPath(grid, parent, node);
+        }
+
+        int col = node % stride;
+        int neighbors[NUM_DIRECTIONS];
+        int count = 0;
+
+        if (node >= stride) neighbors[count++] = node - stride;
+        if (node + stride < grid.size()) neighbors[count++] = node + stride;
+        if (col > 0) neighbors[count++] = node - 1;
+        if (col + 1 < grid.cols) neighbors[count++] = node + 1;
+
+        for (int i = 0; i < count; i++) {
+            int neighbor = neighbors[i];
+            if (state[neighbor] == CLOSED || !isOpenChar(cells[neighbor])) continue;
+
+            int newG = g[node] + 1;
+            if (state[neighbor] == OPEN && g[neighbor] <= newG) continue;
+
+            state[neighbor] = OPEN;
+            g[neighbor] = newG;
+            parent[neighbor] = node;
+            (newG + heuristic(neighbor) == f ? current : next).push_back(neighbor);
+        }
+    }
+
+    return vector<Cell>();
+}
+
+std::vector<Cell> astarPath(const GridView& grid) {
+    SolverContext ctx;
+    return astarPath(grid, ctx);
+}
+
+std::vector<Cell> treePath(const GridView& grid, const MazeTree& tree, Cell from, Cell to) {
+    if (!grid.inBounds(from.r, from.c) || !grid.inBounds(to.r, to.c)) {
+        return vector<Cell>();
+    }
+
+    int a = grid.index(from.r, from.c);
+    int b = grid.index(to.r, to.c);
+    if (tree.depth[a] < 0 || tree.depth[b] < 0) {
+        return vector<Cell>();  // Endpoint is not part of the carved tree
+    }
+
+    // Climb the deeper side until both are level, then climb together until
+    // they meet at the common ancestor. The b side is collected separately
+    // and appended in reverse.
+    vector<Cell> path, tail;
+    while (tree.depth[a] > tree.depth[b]) { path.push_back(grid.cellAt(a)); a = tree.parent[a]; }
+    while (tree.depth[b] > tree.depth[a]) { tail.push_back(grid.cellAt(b)); b = tree.parent[b]; }
+    while (a != b) {
+        path.push_back(grid.cellAt(a));
+        tail.push_back(grid.cellAt(b));
+        a = tree.parent[a];
+        b = tree.parent[b];
+    }
+    path.push_back(grid.cellAt(a));
+    path.insert(path.end(), tail.rbegin(), tail.rend());
+    return path;
+}
+
+std::vector<Cell> treePath(const GridView& grid, const MazeTree& tree) {
+    if (grid.start.r == -1 || grid.exit.r == -1) {
+        return vector<Cell>();
+    }
+    return treePath(grid, tree, grid.start, grid.exit);
+}
+
+std::vector<Cell> bfsPath(const std::vector<std::string>& dungeon) {
+    SolverContext ctx;
+    return bfsPath(dungeon, ctx);
+}
+
+std::vector<Cell> bfsPath(const std::vector<std::string>& dungeon, SolverContext& ctx) {
+    ctx.grid.assign(dungeon);
+    return bfsPath(ctx.grid, ctx);
+}
 
 /**
  * BITMASK OVERVIEW:
@@ -243,143 +654,410 @@ string keyMaskToString(int keyMask) {
 }
 
 /**
- * Helper function to reconstruct path from KeyState parents.
+ * DENSE KEY-DOOR ENGINE:
+ * With at most 6 keys the whole state space is cells * 2^keys, small enough to
+ * index directly. A state is packed as (cellIndex << numKeys) | mask, so
+ * visited becomes a bitset and parents a byte array over that range.
+ *
+ * Only keys that actually appear in the grid get a mask bit, so a map with two
+ * key types searches cells * 4 states instead of cells * 64.
  */
-vector<Cell> reconstructKeyPath(const unordered_map<KeyState, KeyState, KeyStateHash>& parents,
-                               const KeyState& start, const KeyState& goal) {
-    vector<Cell> path;
-    KeyState current = goal;
+struct KeyLayout {
+    int8_t bit[6];   // Local mask bit for key 'a' + i, or -1 if that key is absent
+    int numKeys;     // Number of distinct keys present in the grid
+
+    explicit KeyLayout(const GridView& grid) : numKeys(0) {
+        bool present[6] = {false, false, false, false, false, false};
+        // rows x cols, not size(): an external view's last row may stop at cols
+        for (int r = 0; r < grid.rows; r++) {
+            const char* row = grid.row(r);
+            for (int c = 0; c < grid.cols; c++) {
+                uint8_t cls = cellClass(row[c]);
+                if (cls & CELL_KEY) present[cls & CELL_LETTER_MASK] = true;
+            }
+        }
+        for (int i = 0; i < 6; i++) {
+            bit[i] = present[i] ? static_cast<int8_t>(numKeys++) : -1;
+        }
+    }
+};
 
-    // Follow parent pointers back to start
-    while (!(current.row == start.row && current.col == start.col && current.keyMask == start.keyMask)) {
-        path.push_back(Cell(current.row, current.col));
-        auto it = parents.find(current);
-        if (it == parents.end()) {
-            return vector<Cell>(); // Path reconstruction failed
+// Parent record: bits 0-1 = direction moved to reach the state,
+// bit 2 = a key was picked up on arrival (the parent's mask lacks that bit)
+const uint8_t PARENT_DIR_MASK = 0x3;
+const uint8_t PARENT_PICKED_KEY = 0x4;
+
+/**
+ * Helper function: Walk the packed parent records back from goal to start,
+ * calling visit(cell, code) for every state but the start: the flat cell and
+ * the direction code that reached it, last step first.
+ */
+template <typename StateIndex, typename Visit>
+void walkDenseKeyPath(const GridView& grid, const KeyLayout& layout, const vector<uint8_t>& parent,
+                      StateIndex startState, StateIndex goal, Visit visit) {
+    const int offsets[NUM_DIRECTIONS] = {-grid.stride, grid.stride, -1, 1};
+    const StateIndex maskBits = (StateIndex(1) << layout.numKeys) - 1;
+
+    StateIndex state = goal;
+    while (state != startState) {
+        int cell = static_cast<int>(state >> layout.numKeys);
+        uint8_t mask = static_cast<uint8_t>(state & maskBits);
+        uint8_t code = parent[state];
+
+        visit(cell, static_cast<uint8_t>(code & PARENT_DIR_MASK));
+
+        if (code & PARENT_PICKED_KEY) {
+            mask &= static_cast<uint8_t>(~(1u << layout.bit[grid.cells[cell] - 'a']));
         }
-        current = it->second;
+        cell -= offsets[code & PARENT_DIR_MASK];
+        state = (static_cast<StateIndex>(cell) << layout.numKeys) | mask;
     }
-    path.push_back(Cell(start.row, start.col));
+}
 
-    reverse(path.begin(), path.end());
-    return path;
+/**
+ * Helper function: Key-door path of known distance, sized up front and
+ * filled from the back
+ */
+template <typename StateIndex>
+void reconstructDenseKeyPath(const GridView& grid, const KeyLayout& layout, const vector<uint8_t>& parent,
+                             StateIndex startState, StateIndex goal, int distance, vector<Cell>& path) {
+    path.resize(static_cast<size_t>(distance) + 1);
+    int i = distance;
+    walkDenseKeyPath(grid, layout, parent, startState, goal,
+                     [&](int cell, uint8_t) { path[i--] = grid.cellAt(cell); });
+    path[0] = grid.start;
 }
 
-std::vector<Cell> bfsPathKeys(const std::vector<std::string>& dungeon) {
+template <typename StateIndex>
+void reconstructDenseKeyPath(const GridView& grid, const KeyLayout& layout, const vector<uint8_t>& parent,
+                             StateIndex startState, StateIndex goal, int distance, CompactPath& path) {
+    path = CompactPath(grid.start, static_cast<size_t>(distance));
+    int i = distance - 1;
+    walkDenseKeyPath(grid, layout, parent, startState, goal,
+                     [&](int, uint8_t code) { path.setDirection(i--, code); });
+}
 
-    Cell start = findPosition(dungeon, 'S');
-    Cell exit = findPosition(dungeon, 'E');
+// Helper function: Bytes held by a returned path, for SolverStats
+static size_t pathBytes(const vector<Cell>& path) { return path.capacity() * sizeof(Cell); }
+static size_t pathBytes(const CompactPath& path) { return path.bytes(); }
 
-    if (start.r == -1 || exit.r == -1) {
-        return vector<Cell>();
-    }
+/**
+ * Helper function: BFS over the dense (cell, mask) state space.
+ * All buffers are sized up front, so the main loop never allocates.
+ */
+template <typename StateIndex>
+vector<StateIndex>& keyFrontier(SolverContext& ctx);
 
-    // Initialize BFS data structures with KeyState instead of simple Cell
-    queue<KeyState> bfsQueue;
-    unordered_set<KeyState, KeyStateHash> visited;
-    unordered_map<KeyState, KeyState, KeyStateHash> parents;
+template <>
+vector<uint32_t>& keyFrontier<uint32_t>(SolverContext& ctx) { return ctx.keyFrontier32; }
 
-    // Start with position + no keys (keyMask = 0)
-    KeyState startState(start.r, start.c, 0);
-    bfsQueue.push(startState);
-    visited.insert(startState);
+template <>
+vector<uint64_t>& keyFrontier<uint64_t>(SolverContext& ctx) { return ctx.keyFrontier64; }
 
-    // Main BFS loop with key-door logic
-    while (!bfsQueue.empty()) {
-        KeyState current = bfsQueue.front();
-        bfsQueue.pop();
+/**
+ * Per-solve step tables derived from CELL_CLASSES and the layout:
+ * need[c] = mask bits required to enter c (STEP_BLOCKED for walls and doors
+ * whose key never appears, which no mask has), give[c] = mask bit picked up.
+ * With them a step is one AND test plus one OR, with no per-character branches.
+ */
+const uint8_t STEP_BLOCKED = 0x80;
+
+struct StepTables {
+    uint8_t need[256];
+    uint8_t give[256];
+
+    explicit StepTables(const KeyLayout& layout) {
+        for (int c = 0; c < 256; c++) {
+            uint8_t cls = CELL_CLASSES.classes[c];
+            int bit = layout.bit[cls & CELL_LETTER_MASK];
+            need[c] = 0;
+            give[c] = 0;
+            if (cls & CELL_WALL) need[c] = STEP_BLOCKED;
+            if (cls & CELL_DOOR) need[c] = bit < 0 ? STEP_BLOCKED : static_cast<uint8_t>(1u << bit);
+            if ((cls & CELL_KEY) && bit >= 0) give[c] = static_cast<uint8_t>(1u << bit);
+        }
+    }
+};
 
-        if (current.row == 5/*exit.r*/ && current.col == 8/*exit.c*/) {
-            cout << "Exit found!" << endl;
-            return reconstructKeyPath(parents, startState, current);
+/**
+ * Core of the key-door BFS, specialized on the number of key bits K so the
+ * state shift and mask are constants. The four moves are written out with
+ * offsets from the stride, so the loop body has no direction table lookups.
+ */
+template <typename StateIndex, int K, typename Path>
+Path denseKeySearch(const GridView& grid, const KeyLayout& layout, SolverContext& ctx) {
+    constexpr StateIndex MASK_BITS = (StateIndex(1) << K) - 1;
+    const StateIndex stateCount = static_cast<StateIndex>(grid.size()) << K;
+    const int stride = grid.stride;
+    const int size = grid.size();
+    const int cols = grid.cols;
+    const unsigned char* cells = reinterpret_cast<const unsigned char*>(grid.cells);
+    const size_t scratchBefore = beginStats(ctx);
+    PhaseTimer setupTimer(ctx.stats.setupMs);
+    const StepTables tables(layout);
+
+    // Parent records are only read for visited states, so only the bitset
+    // is cleared; the other buffers just keep their capacity. Unlike the
+    // basic BFS marks this is not generation-stamped: the clear is a memset
+    // of one bit per state, while a stamp check on every step measured
+    // about 30% slower on 31x31 to 255x255 three-key maps.
+    vector<uint64_t>& visited = ctx.keyVisited;
+    vector<uint8_t>& parent = ctx.keyParent;
+    vector<StateIndex>& frontier = keyFrontier<StateIndex>(ctx);
+    visited.assign((stateCount + 63) / 64, 0);
+    if (parent.size() < stateCount) parent.resize(stateCount);
+    if (frontier.size() < stateCount) frontier.resize(stateCount);
+    StateIndex head = 0, tail = 0;
+
+    const int exitIdx = grid.index(grid.exit.r, grid.exit.c);
+    const StateIndex startState =
+        static_cast<StateIndex>(grid.index(grid.start.r, grid.start.c)) << K;
+
+    frontier[tail++] = startState;
+    visited[startState >> 6] |= uint64_t(1) << (startState & 63);
+
+    StateIndex goal = 0;
+    bool found = false;
+    int depth = 0;
+    StateIndex levelEnd = tail;
+    setupTimer.stop();
+
+    // One move: returns true once the exit has been reached
+    auto step = [&](int next, uint8_t mask, uint8_t dir) {
+        unsigned char cellChar = cells[next];
+        if (tables.need[cellChar] & ~mask) return false;
+
+        uint8_t newMask = mask | tables.give[cellChar];
+        StateIndex newState = (static_cast<StateIndex>(next) << K) | newMask;
+        uint64_t& word = visited[newState >> 6];
+        uint64_t bitMask = uint64_t(1) << (newState & 63);
+        if (word & bitMask) return false;
+
+        word |= bitMask;
+        parent[newState] = static_cast<uint8_t>(dir | (newMask != mask ? PARENT_PICKED_KEY : 0));
+
+        // BFS discovers states in distance order, so the first time the
+        // exit cell is reached (with any mask) we already have a shortest path
+        if (next == exitIdx) {
+            goal = newState;
+            return found = true;
+        }
+        frontier[tail++] = newState;
+        return false;
+    };
+
+    PhaseTimer searchTimer(ctx.stats.searchMs);
+    while (head < tail) {
+        if (head == levelEnd) {
+            depth++;
+            levelEnd = tail;
         }
+        StateIndex state = frontier[head++];
+        int current = static_cast<int>(state >> K);
+        uint8_t mask = static_cast<uint8_t>(state & MASK_BITS);
+        int col = current % stride;
+        recordExpansion(ctx, "bfsPathKeys", static_cast<size_t>(head), static_cast<size_t>(tail - head),
+                        current, mask);
+
+        // Up, down, left, right (DIRECTIONS order, matching PARENT_DIR_MASK codes)
+        if ((current >= stride && step(current - stride, mask, 0)) ||
+            (current + stride < size && step(current + stride, mask, 1)) ||
+            (col > 0 && step(current - 1, mask, 2)) ||
+            (col + 1 < cols && step(current + 1, mask, 3))) {
+            break;
+        }
+    }
 
-        // Explore all 4 neighboring directions
-        for (int i = 0; i < NUM_DIRECTIONS; i++) {
-            int newRow = current.row + DIRECTIONS[i][0];
-            int newCol = current.col + DIRECTIONS[i][1];
+    ctx.explored = static_cast<size_t>(head);
+    searchTimer.stop();
 
-            if (!isValidPosition(dungeon, newRow, newCol)) continue;
+    // The goal was discovered while expanding a state at depth
+    Path path;
+    if (found) {
+        PhaseTimer reconstructTimer(ctx.stats.reconstructMs);
+        reconstructDenseKeyPath(grid, layout, parent, startState, goal, depth + 1, path);
+    }
+    finishStats(ctx, scratchBefore, pathBytes(path));
+    return path;
+}
 
-            char cellChar = dungeon[newRow][newCol];
+template <typename StateIndex, typename Path>
+Path denseKeySearch(const GridView& grid, const KeyLayout& layout, SolverContext& ctx) {
+    switch (layout.numKeys) {
+        case 1: return denseKeySearch<StateIndex, 1, Path>(grid, layout, ctx);
+        case 2: return denseKeySearch<StateIndex, 2, Path>(grid, layout, ctx);
+        case 3: return denseKeySearch<StateIndex, 3, Path>(grid, layout, ctx);
+        case 4: return denseKeySearch<StateIndex, 4, Path>(grid, layout, ctx);
+        case 5: return denseKeySearch<StateIndex, 5, Path>(grid, layout, ctx);
+        default: return denseKeySearch<StateIndex, 6, Path>(grid, layout, ctx);
+    }
+}
 
-            // TODO #1: Implement door checking logic
-            if (cellChar >= 'A' && cellChar <= 'F' && cellChar !='S' && cellChar != 'E')
-            {
-                if (!canPassDoor(cellChar, current.keyMask)) continue;
-            }
+std::vector<Cell> bfsPathKeys(const GridView& grid, SolverContext& ctx) {
+    if (grid.start.r == -1 || grid.exit.r == -1) {
+        return vector<Cell>();
+    }
 
-            // TODO #2: Implement key collection logic
-            int newKeyMask = current.keyMask;
+    KeyLayout layout(grid);
 
-            if (cellChar >= 'a' && cellChar <= 'f') newKeyMask = collectKey(cellChar, newKeyMask);
+    // Without keys every door stays shut, which is exactly the basic BFS
+    if (layout.numKeys == 0) {
+        return bfsPath(grid, ctx);
+    }
 
-            // TODO #3: Create new state with updated key information
-            KeyState newState(newRow, newCol, newKeyMask);  // FIX: Use newKeyMask instead!
+    // 32-bit state indices unless the state space is too big for them
+    uint64_t stateCount = static_cast<uint64_t>(grid.size()) << layout.numKeys;
+    if (stateCount <= UINT32_MAX) {
+        return denseKeySearch<uint32_t, vector<Cell>>(grid, layout, ctx);
+    }
+    return denseKeySearch<uint64_t, vector<Cell>>(grid, layout, ctx);
+}
 
-            if (visited.find(newState) == visited.end()) {
-                bfsQueue.push(newState);
-                visited.insert(newState);
-                parents[newState] = current;
-            }
-        }
+CompactPath bfsPathKeysCompact(const GridView& grid, SolverContext& ctx) {
+    if (grid.start.r == -1 || grid.exit.r == -1) {
+        return CompactPath();
     }
 
-    return vector<Cell>();
+    KeyLayout layout(grid);
+    if (layout.numKeys == 0) {
+        return bfsPathCompact(grid, ctx);
+    }
+
+    uint64_t stateCount = static_cast<uint64_t>(grid.size()) << layout.numKeys;
+    if (stateCount <= UINT32_MAX) {
+        return denseKeySearch<uint32_t, CompactPath>(grid, layout, ctx);
+    }
+    return denseKeySearch<uint64_t, CompactPath>(grid, layout, ctx);
 }
 
-#ifdef IMPLEMENT_OPTIONAL_FUNCTIONS
-/**
- * OPTIONAL INTERMEDIATE CHALLENGE:
- * Practice bitmask operations by counting reachable keys (ignoring doors).
- * This is simpler than full key-door BFS and good preparation for bitmask concepts.
- *
- * For bitmask tutorials and practice exercises, see BITMASK_BFS_GUIDE.md
- */
-int countReachableKeys(const std::vector<std::string>& dungeon) {
-    // OPTIONAL CHALLENGE: Practice bitmask operations in a simpler context
-    // This function uses basic BFS but practices key collection with bitmasks
-    // Good preparation for understanding the full key-door BFS complexity
+std::vector<Cell> bfsPathKeys(const GridView& grid) {
+    SolverContext ctx;
+    return bfsPathKeys(grid, ctx);
+}
 
-    Cell start = findPosition(dungeon, 'S');
-    if (start.r == -1) return 0;
+std::vector<Cell> bfsPathKeys(const std::vector<std::string>& dungeon) {
+    SolverContext ctx;
+    return bfsPathKeys(dungeon, ctx);
+}
+
+std::vector<Cell> bfsPathKeys(const std::vector<std::string>& dungeon, SolverContext& ctx) {
+    ctx.grid.assign(dungeon);
+    return bfsPathKeys(ctx.grid, ctx);
+}
 
-    // TODO #1: Set up basic BFS data structures
-    // HINT: You need queue<Cell>, unordered_set<Cell, CellHash>, and int keyMask = 0
+std::vector<std::vector<Cell>> solveBatch(const Grid* dungeons, size_t count, SolveMode mode,
+                                          ThreadPool& pool) {
+    vector<vector<Cell>> paths(count);
 
-    // YOUR CODE HERE: Initialize BFS structures
+    // One scratch context per worker, reused for every dungeon it solves
+    vector<SolverContext> contexts(pool.size());
+
+    pool.parallelFor(count, [&](size_t index, unsigned worker) {
+        SolverContext& ctx = contexts[worker];
+        paths[index] = (mode == SolveMode::Keys) ? bfsPathKeys(dungeons[index], ctx)
+                                                 : bfsPath(dungeons[index], ctx);
+    });
+
+    return paths;
+}
 
-    // TODO #2: Implement main BFS loop to explore reachable areas
-    // HINT: This is similar to basic BFS, but collect keys when you find them
-    // ALGORITHM:
-    // 1. While queue not empty: dequeue current
-    // 2. If current cell is a key ('a' to 'f'), use collectKey() to update keyMask
-    // 3. Explore neighbors using isValidPosition() (ignore doors for this version)
-    // 4. Add unvisited neighbors to queue and visited set
+std::vector<std::vector<Cell>> solveBatch(const std::vector<Grid>& dungeons, SolveMode mode,
+                                          ThreadPool& pool) {
+    return solveBatch(dungeons.data(), dungeons.size(), mode, pool);
+}
 
-    // YOUR CODE HERE: BFS loop with key collection
+/**
+ * Helper function: Flood fill from the start over cells whose class has none
+ * of the blocked bits, marking only (no parents). found(next) is called for
+ * every newly reached cell; the fill stops as soon as it returns true.
+ *
+ * @return true if found() stopped the fill
+ */
+template <typename Found>
+static bool floodFromStart(const GridView& grid, uint8_t blocked, SolverContext& ctx, Found found) {
+    const int stride = grid.stride;
+    const char* cells = grid.cells;
+    vector<int>& frontier = ctx.frontier;
+    if (frontier.size() < static_cast<size_t>(grid.size())) frontier.resize(grid.size());
+    const uint32_t seen = ctx.beginSearch(grid.size());
+    uint32_t* mark = ctx.mark.data();
+    int head = 0, tail = 0;
+
+    const int startIdx = grid.index(grid.start.r, grid.start.c);
+    frontier[tail++] = startIdx;
+    mark[startIdx] = seen;
+
+    while (head < tail) {
+        int current = frontier[head++];
+        int col = current % stride;
+        int neighbors[NUM_DIRECTIONS];
+        int count = 0;
+        if (current >= stride) neighbors[count++] = current - stride;
+        if (current + stride < grid.size()) neighbors[count++] = current + stride;
+        if (col > 0) neighbors[count++] = current - 1;
+        if (col + 1 < grid.cols) neighbors[count++] = current + 1;
+
+        for (int i = 0; i < count; i++) {
+            int next = neighbors[i];
+            if (mark[next] == seen || (cellClass(cells[next]) & blocked)) continue;
+            mark[next] = seen;
+            if (found(next)) {
+                ctx.explored = head;
+                return true;
+            }
+            frontier[tail++] = next;
+        }
+    }
 
-    // TODO #3: Count how many different keys were collected
-    // HINT: Count the number of set bits in keyMask
-    // Each bit represents one key: bit 0 = 'a', bit 1 = 'b', etc.
+    ctx.explored = head;
+    return false;
+}
 
-    // YOUR CODE HERE: Count bits in keyMask
+bool exitReachable(const GridView& grid, SolverContext& ctx) {
+    ctx.explored = 0;
+    if (grid.start.r == -1 || grid.exit.r == -1) return false;
 
-    // DEBUGGING TIPS:
-    // 1. Print keyMask value to see which bits are set
-    // 2. Use keyMaskToString() helper to see collected keys
-    // 3. Test on simple dungeons with 1-2 keys first
-    // 4. Remember: this version ignores doors completely
+    // The exit is checked when first seen, not when dequeued
+    const int exitIdx = grid.index(grid.exit.r, grid.exit.c);
+    if (grid.start == grid.exit) return true;
+    return floodFromStart(grid, CELL_BLOCKED, ctx, [&](int next) { return next == exitIdx; });
+}
 
-    return 0;  // TODO: Return actual count
+uint8_t reachableKeys(const GridView& grid, bool throughDoors, SolverContext& ctx) {
+    ctx.explored = 0;
+    if (grid.start.r == -1) return 0;
+
+    // Keys present at all, so the fill can stop once it has every one of them
+    uint8_t present = 0;
+    for (int r = 0; r < grid.rows; r++) {
+        const char* row = grid.row(r);
+        for (int c = 0; c < grid.cols; c++) {
+            uint8_t cls = cellClass(row[c]);
+            if (cls & CELL_KEY) present |= static_cast<uint8_t>(1u << (cls & CELL_LETTER_MASK));
+        }
+    }
+    if (present == 0) return 0;
+
+    uint8_t found = 0;
+    floodFromStart(grid, throughDoors ? CELL_WALL : CELL_BLOCKED, ctx, [&](int next) {
+        uint8_t cls = cellClass(grid.cells[next]);
+        if (cls & CELL_KEY) found |= static_cast<uint8_t>(1u << (cls & CELL_LETTER_MASK));
+        return found == present;
+    });
+    return found;
 }
-#else
+
 /**
- * Stub implementation when optional functions are disabled.
- * This prevents compilation errors when the function is not implemented.
+ * Number of distinct keys reachable from 'S' when doors are ignored (only
+ * walls block): a basic flood fill collecting a key bitmask, see
+ * BITMASK_BFS_GUIDE.md.
  */
 int countReachableKeys(const std::vector<std::string>& dungeon) {
-    // Optional function not implemented - returning 0
-    return 0;
+    Grid grid(dungeon);
+    SolverContext ctx;
+    uint8_t keyMask = reachableKeys(grid, true, ctx);
+
+    int count = 0;
+    for (; keyMask != 0; keyMask &= keyMask - 1) count++;
+    return count;
 }
-#endif
@@ -2,6 +2,78 @@
 #include <vector>
 #include <string>
 #include "cell.h"
+#include "grid.h"
+#include "thread_pool.h"
+#include "solver_stats.h"
+#include "compact_path.h"
+#include <cstdint>
+
+/**
+ * Reusable scratch buffers for the Grid solvers. Passing the same context to
+ * many solves lets the queue, mark and parent arrays keep their capacity,
+ * so after the first (largest) grid there are no per-solve allocations other
+ * than the returned path. A context must not be shared between threads.
+ *
+ * Per-cell search state lives in mark as generation stamps: each search
+ * reserves fresh stamp values with beginSearch(), and any value below the
+ * search's base means "not seen yet". Starting a search therefore costs
+ * O(1) instead of clearing an array the size of the grid; the array is only
+ * wiped when the 32-bit stamp counter wraps.
+ */
+struct SolverContext {
+    // Basic BFS / bidirectional BFS / A*: one slot per cell
+    std::vector<int> frontier;
+    std::vector<uint32_t> mark;
+    std::vector<int> parent;
+    uint32_t nextStamp = 1;
+
+    // Key-door BFS: one slot (or bit) per (cell, keyMask) state. keyVisited
+    // is a bitset cleared at the start of each solve rather than stamped
+    // like mark, since clearing one bit per state is cheaper than a stamp
+    // check on every step
+    std::vector<uint64_t> keyVisited;
+    std::vector<uint8_t> keyParent;
+    std::vector<uint32_t> keyFrontier32;
+    std::vector<uint64_t> keyFrontier64;
+
+    // Bidirectional BFS / A*: second queue (or bucket) and per-cell distance
+    std::vector<int> backFrontier;
+    std::vector<int> dist;
+
+    // Conversion target for the vector<string> overloads
+    Grid grid;
+
+    // Number of cells (or states) the last solve expanded
+    size_t explored = 0;
+
+    // Detailed cost of the last bfsPath / bfsPathKeys solve and an optional
+    // sampling hook; both are inert unless ENABLE_SOLVER_STATS is defined
+    SolverStats stats;
+    SolverTrace trace;
+
+    /**
+     * Starts a search over cells slots: grows mark if needed and reserves
+     * stamps consecutive stamp values for it.
+     *
+     * @return base; mark[i] == base + s means state s in this search, and
+     *         mark[i] < base means the cell is untouched
+     */
+    uint32_t beginSearch(size_t cells, uint32_t stamps = 1);
+
+    /**
+     * Presizes the per-cell buffers for grids of up to cells slots, so even
+     * the first solve does not allocate scratch space.
+     */
+    void reserve(size_t cells);
+};
+
+/**
+ * Which solver a batch uses for every dungeon.
+ */
+enum class SolveMode {
+    Basic,  // bfsPath: doors are walls
+    Keys    // bfsPathKeys: collect keys to open doors
+};
 
 /**
  * Finds the shortest path from start 'S' to exit 'E' in the dungeon
@@ -14,6 +86,90 @@
  */
 std::vector<Cell> bfsPath(const std::vector<std::string>& dungeon);
 
+/**
+ * Quiet bfsPath on a vector<string> dungeon. The dungeon is copied into
+ * ctx.grid, whose storage is reused, so repeated small-map queries don't
+ * allocate beyond the returned path.
+ */
+std::vector<Cell> bfsPath(const std::vector<std::string>& dungeon, SolverContext& ctx);
+
+/**
+ * Same search as bfsPath above, run directly on the flat Grid representation.
+ * Visited and parent tracking use flat arrays indexed by grid.index(r, c)
+ * instead of hash containers, so large dungeons avoid per-node allocation.
+ *
+ * @param grid Flat dungeon with precomputed start and exit positions
+ * @return Vector of Cell coordinates representing the path from S to E.
+ *         Returns empty vector if no path exists.
+ */
+std::vector<Cell> bfsPath(const GridView& grid);
+
+/**
+ * bfsPath on a Grid using the caller's scratch buffers.
+ */
+std::vector<Cell> bfsPath(const GridView& grid, SolverContext& ctx);
+
+/**
+ * Basic BFS between arbitrary endpoints instead of S and E. The endpoints
+ * themselves are not checked for passability, so any cell can be a source.
+ *
+ * @return Path from `from` to `to`, or empty if unreachable or out of bounds
+ */
+std::vector<Cell> bfsPath(const GridView& grid, Cell from, Cell to, SolverContext& ctx);
+
+/**
+ * bfsPath returning a CompactPath: the BFS tracks level boundaries, so the
+ * exit's distance is known when it is dequeued and the 2-bit step codes are
+ * written straight into a buffer of that size. ctx.stats.bytesAllocated
+ * counts the packed bytes instead of a vector<Cell>.
+ */
+CompactPath bfsPathCompact(const GridView& grid, SolverContext& ctx);
+CompactPath bfsPathCompact(const GridView& grid, Cell from, Cell to, SolverContext& ctx);
+
+/**
+ * Bidirectional variant of bfsPath: expands whole BFS levels alternately from
+ * S and from E (always the smaller frontier) until the two searches meet.
+ * In open dungeons this explores roughly two small balls instead of one big
+ * one. The result is still a shortest path in the same form as bfsPath.
+ * ctx.explored reports how many cells were expanded, for comparison with bfsPath.
+ *
+ * @param grid Flat dungeon with precomputed start and exit positions
+ * @return Vector of Cell coordinates from S to E, or empty if no path exists
+ */
+std::vector<Cell> bfsPathBidirectional(const GridView& grid, SolverContext& ctx);
+std::vector<Cell> bfsPathBidirectional(const GridView& grid);
+
+/**
+ * A* search with the Manhattan-distance heuristic. Since every move costs 1,
+ * the open list is a two-bucket queue (f and f + 2) of plain index arrays
+ * instead of a binary heap. Returns a path of the same length as bfsPath but
+ * expands far fewer cells when the exit lies in the direction of open space.
+ * ctx.explored reports the number of cells expanded.
+ *
+ * @param grid Flat dungeon with precomputed start and exit positions
+ * @return Vector of Cell coordinates from S to E, or empty if no path exists
+ */
+std::vector<Cell> astarPath(const GridView& grid, SolverContext& ctx);
+std::vector<Cell> astarPath(const GridView& grid);
+
+/**
+ * Search-free solver for perfect mazes: follows the spanning-tree parent
+ * pointers recorded by generateDungeonGrid(..., tree) from both endpoints up
+ * to their common ancestor. Runs in O(path length). For roomRate = 0 the
+ * result is the unique (and therefore shortest) path; with rooms it is still
+ * a valid path along the carved tree, but may be longer than bfsPath's.
+ *
+ * @param grid Dungeon the tree was generated with
+ * @param tree Spanning tree returned by the generator
+ * @return Path from S to E, or empty if an endpoint is not in the tree
+ */
+std::vector<Cell> treePath(const GridView& grid, const MazeTree& tree);
+
+/**
+ * treePath between arbitrary carved cells instead of S and E.
+ */
+std::vector<Cell> treePath(const GridView& grid, const MazeTree& tree, Cell from, Cell to);
+
 /**
  * Advanced pathfinding that handles keys and doors using state augmentation.
  * The state includes position (row, col) plus a bitmask of collected keys.
@@ -26,6 +182,55 @@ std::vector<Cell> bfsPath(const std::vector<std::string>& dungeon);
  */
 std::vector<Cell> bfsPathKeys(const std::vector<std::string>& dungeon);
 
+/**
+ * Quiet bfsPathKeys on a vector<string> dungeon, converted through ctx.grid.
+ */
+std::vector<Cell> bfsPathKeys(const std::vector<std::string>& dungeon, SolverContext& ctx);
+
+/**
+ * Key-door search on the flat Grid over a dense (cell, keyMask) state space.
+ * Visited is a bitset and parents a one-byte-per-state array, both sized
+ * rows * cols * 2^k where k is the number of distinct keys present, so the
+ * cost is linear in the state count and the search loop never allocates.
+ * The search core is compiled once per k (1-6), with door/key checks done
+ * through constexpr character tables; k = 0 runs plain bfsPath.
+ *
+ * @param grid Flat dungeon with precomputed start and exit positions
+ * @return Vector of Cell coordinates representing the path from S to E.
+ *         Returns empty vector if no path exists.
+ */
+std::vector<Cell> bfsPathKeys(const GridView& grid);
+
+/**
+ * bfsPathKeys on a Grid using the caller's scratch buffers.
+ */
+std::vector<Cell> bfsPathKeys(const GridView& grid, SolverContext& ctx);
+
+/**
+ * bfsPathKeys returning a CompactPath (see bfsPathCompact).
+ */
+CompactPath bfsPathKeysCompact(const GridView& grid, SolverContext& ctx);
+
+/**
+ * Solves many independent dungeons in parallel. Work is spread over the pool
+ * with work stealing, and each worker keeps one SolverContext for all of its
+ * solves, so scratch buffers are allocated once per worker, not per dungeon.
+ *
+ * @param dungeons Pointer to the first of count dungeons
+ * @param count Number of dungeons
+ * @param mode Basic (bfsPath) or Keys (bfsPathKeys)
+ * @param pool Pool to run on (defaults to the shared hardware-sized pool)
+ * @return paths[i] is the solution for dungeons[i] (empty if unsolvable)
+ */
+std::vector<std::vector<Cell>> solveBatch(const Grid* dungeons, size_t count, SolveMode mode,
+                                          ThreadPool& pool = ThreadPool::shared());
+
+/**
+ * Convenience overload for a whole vector of dungeons.
+ */
+std::vector<std::vector<Cell>> solveBatch(const std::vector<Grid>& dungeons, SolveMode mode,
+                                          ThreadPool& pool = ThreadPool::shared());
+
 /**
  * Helper function to find the position of a specific character in the dungeon.
  * Useful for locating the start 'S' and exit 'E' positions.
@@ -67,23 +272,26 @@ bool canPassDoor(char door, int keyMask);
  */
 int collectKey(char key, int keyMask);
 
-// Uncomment the line below if you want to implement the optional intermediate challenge
-// #define IMPLEMENT_OPTIONAL_FUNCTIONS
+/**
+ * Yes/no reachability of E from S under the basic rules (walls and doors
+ * block). Marks visited cells but keeps no parents and builds no path, and
+ * stops the moment E is first seen. For many queries on the same dungeon
+ * use ConnectivityLabels instead.
+ */
+bool exitReachable(const GridView& grid, SolverContext& ctx);
 
-#ifdef IMPLEMENT_OPTIONAL_FUNCTIONS
 /**
- * OPTIONAL INTERMEDIATE CHALLENGE (easier than full key-door BFS):
- * Implement a function that just counts how many keys are reachable from start,
- * ignoring doors completely. This helps students practice the bitmask concept
- * without the complexity of door logic.
- * 
- * TO ENABLE THIS CHALLENGE:
- * 1. Uncomment the #define IMPLEMENT_OPTIONAL_FUNCTIONS line above
- * 2. Implement this function in solver.cpp
- * 3. The main program will automatically test it
- * 
+ * Keys reachable from S without opening any doors (or with every door
+ * treated as open when throughDoors is set). Bit i is key 'a' + i. Stops as
+ * soon as every key present on the map has been found.
+ */
+uint8_t reachableKeys(const GridView& grid, bool throughDoors, SolverContext& ctx);
+
+/**
+ * Counts how many distinct keys are reachable from start, ignoring doors
+ * completely (only walls block).
+ *
  * @param dungeon The dungeon grid
  * @return Number of unique keys reachable from start position
  */
-int countReachableKeys(const std::vector<std::string>& dungeon);
-#endif
\ No newline at end of file
+int countReachableKeys(const std::vector<std::string>& dungeon);
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+
+// Uncomment the line below (or build with DEFINES += ENABLE_SOLVER_STATS) to
+// have the Grid solvers fill SolverContext::stats and call SolverContext::trace.
+// When it is off, every stats and trace statement compiles away.
+// #define ENABLE_SOLVER_STATS
+
+#ifdef ENABLE_SOLVER_STATS
+constexpr bool SOLVER_STATS_ENABLED = true;
+#else
+constexpr bool SOLVER_STATS_ENABLED = false;
+#endif
+
+/**
+ * What the last bfsPath / bfsPathKeys solve cost. Reset at the start of
+ * every solve; only filled in when ENABLE_SOLVER_STATS is defined.
+ */
+struct SolverStats {
+    size_t expanded = 0;            // Cells (or cell, mask states) dequeued
+    size_t statesPerMask[64] = {};  // Expanded states by key mask (mask 0 for bfsPath)
+    size_t peakQueue = 0;           // Largest number of queued, unexpanded entries
+    size_t bytesAllocated = 0;      // Scratch growth during the solve plus the returned path
+    double setupMs = 0;             // Sizing and clearing scratch buffers
+    double searchMs = 0;            // Main search loop
+    double reconstructMs = 0;       // Walking parents back into a path
+
+    void reset() { *this = SolverStats(); }
+};
+
+/**
+ * One tracing sample, taken every SolverTrace::interval expansions.
+ */
+struct TraceSample {
+    const char* solver;     // "bfsPath" or "bfsPathKeys"
+    size_t expanded;        // Entries dequeued so far
+    size_t queued;          // Entries waiting in the queue
+    int cell;               // Flat grid index being expanded
+    uint32_t keyMask;       // Key mask of that state (0 for bfsPath)
+};
+
+using TraceHook = void (*)(const TraceSample& sample, void* user);
+
+/**
+ * Optional sampling hook. With hook left null (or stats disabled) the solvers
+ * never call it.
+ */
+struct SolverTrace {
+    TraceHook hook = nullptr;
+    void* user = nullptr;       // Passed back to hook unchanged
+    size_t interval = 4096;     // Expansions between samples; must be > 0
+};
+
+/**
+ * Adds the wall time from construction to stop() (or the end of its scope)
+ * to a SolverStats phase field. An empty object when stats are disabled.
+ */
+#ifdef ENABLE_SOLVER_STATS
+class PhaseTimer {
+public:
+    explicit PhaseTimer(double& target) : target(&target), begin(std::chrono::steady_clock::now()) {}
+    ~PhaseTimer() { stop(); }
+
+    void stop() {
+        if (!target) return;
+        *target += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        target = nullptr;
+    }
+
+private:
+    double* target;
+    std::chrono::steady_clock::time_point begin;
+};
+#else
+class PhaseTimer {
+public:
+    explicit PhaseTimer(double&) {}
+    void stop() {}
+};
+#endif
@@ -0,0 +1,143 @@
+/**
+ * Dungeon Pathfinder - Thread Pool
+ *
+ * Work-stealing fork-join pool used by the batch generation and solving APIs.
+ */
+
+#include "thread_pool.h"
+#include <algorithm>
+
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+    ranges = vector<WorkRange>(threads);
+
+    for (unsigned worker = 1; worker < threads; worker++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& worker : workers) worker.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+/**
+ * Helper function: take the next chunk from the front of our own share
+ */
+bool ThreadPool::takeOwn(unsigned worker, size_t& begin, size_t& end) {
+    WorkRange& range = ranges[worker];
+    lock_guard<std::mutex> lock(range.lock);
+    if (range.begin >= range.end) return false;
+
+    begin = range.begin;
+    end = min(range.end, begin + chunkSize);
+    range.begin = end;
+    return true;
+}
+
+/**
+ * Helper function: move the back half of another worker's remaining share
+ * into the thief's own, now empty, share
+ */
+bool ThreadPool::steal(unsigned thief) {
+    const unsigned count = size();
+    for (unsigned attempt = 0; attempt < count; attempt++) {
+        // Start with the neighbor so thieves don't all pile onto worker 0
+        unsigned victim = (thief + 1 + attempt) % count;
+        if (victim == thief) continue;
+
+        size_t begin, end;
+        {
+            lock_guard<std::mutex> lock(ranges[victim].lock);
+            WorkRange& range = ranges[victim];
+            size_t remaining = range.end > range.begin ? range.end - range.begin : 0;
+            if (remaining == 0) continue;
+
+            size_t take = (remaining + 1) / 2;
+            begin = range.end - take;
+            end = range.end;
+            range.end = begin;
+        }
+
+        lock_guard<std::mutex> lock(ranges[thief].lock);
+        ranges[thief].begin = begin;
+        ranges[thief].end = end;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Helper function: drain our own share, then keep stealing until every
+ * share is empty
+ */
+void ThreadPool::runShare(unsigned worker) {
+    do {
+        size_t begin, end;
+        while (takeOwn(worker, begin, end)) {
+            for (size_t index = begin; index < end; index++) {
+                (*job)(index, worker);
+            }
+        }
+    } while (steal(worker));
+}
+
+void ThreadPool::workerLoop(unsigned worker) {
+    unsigned long long seen = 0;
+    for (;;) {
+        {
+            unique_lock<std::mutex> lock(stateMutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        runShare(worker);
+
+        {
+            lock_guard<std::mutex> lock(stateMutex);
+            busyWorkers--;
+        }
+        done.notify_one();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const function<void(size_t, unsigned)>& task) {
+    if (count == 0) return;
+
+    lock_guard<std::mutex> submit(submitMutex);
+
+    {
+        lock_guard<std::mutex> lock(stateMutex);
+        job = &task;
+
+        // Even initial split; small chunks so work is left to steal late
+        const unsigned shares = size();
+        chunkSize = max<size_t>(1, count / (shares * 16));
+        for (unsigned worker = 0; worker < shares; worker++) {
+            lock_guard<std::mutex> rangeLock(ranges[worker].lock);
+            ranges[worker].begin = count * worker / shares;
+            ranges[worker].end = count * (worker + 1) / shares;
+        }
+        busyWorkers = static_cast<unsigned>(workers.size());
+        generation++;
+    }
+    wake.notify_all();
+
+    runShare(0);
+
+    unique_lock<std::mutex> lock(stateMutex);
+    done.wait(lock, [&] { return busyWorkers == 0; });
+    job = nullptr;
+}
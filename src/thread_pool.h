@@ -0,0 +1,80 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed-size pool of worker threads for batch generation and solving.
+ *
+ * Work is submitted as an index range with parallelFor; each call blocks until
+ * every index has been processed. The calling thread joins in as worker 0, so
+ * a pool of N threads starts N - 1 background threads.
+ *
+ * Scheduling is work stealing: the range is split evenly up front, each worker
+ * takes small chunks from the front of its own share, and a worker that runs
+ * dry steals the back half of the first non-empty share it finds, scanning
+ * the other workers round-robin from its right-hand neighbour.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads Total number of workers including the caller;
+     *                0 means one per hardware thread
+     */
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of workers, including the calling thread
+    unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    /**
+     * Runs task(index, worker) for every index in [0, count), spread over all
+     * workers. worker is in [0, size()) and identifies the thread, so callers
+     * can keep per-worker scratch state without locking.
+     *
+     * Calls from different threads are serialized. Calling parallelFor from
+     * inside a task is not supported.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t index, unsigned worker)>& task);
+
+    /**
+     * Process-wide pool sized to the hardware, created on first use.
+     */
+    static ThreadPool& shared();
+
+private:
+    /**
+     * One worker's share of the current job, [begin, end). The owner takes
+     * from the front and thieves take from the back, both under the lock.
+     */
+    struct alignas(64) WorkRange {
+        std::mutex lock;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    void workerLoop(unsigned worker);
+    void runShare(unsigned worker);
+    bool takeOwn(unsigned worker, size_t& begin, size_t& end);
+    bool steal(unsigned thief);
+
+    std::vector<std::thread> workers;
+    std::mutex submitMutex;     // One parallelFor at a time
+    std::mutex stateMutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    // Current job; published under stateMutex, ranges claimed per worker
+    const std::function<void(size_t, unsigned)>* job = nullptr;
+    size_t chunkSize = 1;
+    std::vector<WorkRange> ranges;
+    unsigned busyWorkers = 0;
+    unsigned long long generation = 0;
+    bool stopping = false;
+};